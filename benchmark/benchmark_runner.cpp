@@ -8,6 +8,7 @@
 #include "duckdb.hpp"
 #include "duckdb_benchmark.hpp"
 #include "interpreted_benchmark.hpp"
+#include "workload_replay.hpp"
 
 #define CATCH_CONFIG_RUNNER
 #include "catch.hpp"
@@ -238,6 +239,12 @@ void print_help() {
 	fprintf(stderr, "              --log=[file]           Move log output to file\n");
 	fprintf(stderr, "              --info                 Prints info about the benchmark\n");
 	fprintf(stderr, "              --query                Prints query of the benchmark\n");
+	fprintf(stderr, "              --replay=[trace]       Replay a query trace instead of running benchmarks\n");
+	fprintf(stderr, "              --replay-init=[file]   SQL script run before the replay, e.g. to load the data\n");
+	fprintf(stderr, "              --replay-lookup=[sql]  Statement with one parameter run by the LOOKUP queries\n");
+	fprintf(stderr, "              --replay-rate=n        Queries per second (default: the timestamps of the trace)\n");
+	fprintf(stderr, "              --replay-clients=n     Number of client threads of the replay (default: 1)\n");
+	fprintf(stderr, "              --replay-csv=[file]    Write the per second statistics of the replay to file\n");
 	fprintf(stderr,
 	        "              [name_pattern]         Run only the benchmark which names match the specified name pattern, "
 	        "e.g., DS.* for TPC-DS benchmarks\n");
@@ -245,6 +252,13 @@ void print_help() {
 
 enum ConfigurationError { None, BenchmarkNotFound, InfoWithoutBenchmarkName };
 
+WorkloadReplayConfiguration replay_configuration;
+
+//! The value of an argument of the form --name=value, the value may contain '=' itself
+static string GetArgumentValue(const string &arg) {
+	return arg.substr(arg.find('=') + 1);
+}
+
 void LoadInterpretedBenchmarks() {
 	// load interpreted benchmarks
 	unique_ptr<FileSystem> fs = FileSystem::CreateLocal();
@@ -285,6 +299,20 @@ void parse_arguments(const int arg_counter, char const *const *arg_values) {
 		} else if (arg == "--query") {
 			// write group of benchmark
 			instance.configuration.meta = BenchmarkMetaType::QUERY;
+		} else if (StringUtil::StartsWith(arg, "--replay=")) {
+			replay_configuration.trace_path = GetArgumentValue(arg);
+		} else if (StringUtil::StartsWith(arg, "--replay-init=")) {
+			replay_configuration.init_path = GetArgumentValue(arg);
+		} else if (StringUtil::StartsWith(arg, "--replay-lookup=")) {
+			replay_configuration.lookup_query = GetArgumentValue(arg);
+		} else if (StringUtil::StartsWith(arg, "--replay-rate=")) {
+			replay_configuration.rate =
+			    Value(GetArgumentValue(arg)).DefaultCastAs(LogicalType::DOUBLE).GetValue<double>();
+		} else if (StringUtil::StartsWith(arg, "--replay-clients=")) {
+			replay_configuration.clients =
+			    Value(GetArgumentValue(arg)).DefaultCastAs(LogicalType::UINTEGER).GetValue<uint32_t>();
+		} else if (StringUtil::StartsWith(arg, "--replay-csv=")) {
+			replay_configuration.csv_path = GetArgumentValue(arg);
 		} else if (StringUtil::StartsWith(arg, "--out=") || StringUtil::StartsWith(arg, "--log=")) {
 			auto splits = StringUtil::Split(arg, '=');
 			if (splits.size() != 2) {
@@ -387,6 +415,12 @@ int main(int argc, char **argv) {
 	// load interpreted benchmarks before doing anything else
 	LoadInterpretedBenchmarks();
 	parse_arguments(argc, argv);
+	if (!replay_configuration.trace_path.empty()) {
+		replay_configuration.threads = BenchmarkRunner::GetInstance().threads;
+		WorkloadReplay replay(replay_configuration);
+		replay.Run();
+		return 0;
+	}
 	const auto configuration_error = run_benchmarks();
 	if (configuration_error != ConfigurationError::None) {
 		print_error_message(configuration_error);
@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+//                         DuckDB
+//
+// workload_replay.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/atomic.hpp"
+
+#include <chrono>
+
+namespace duckdb {
+
+struct WorkloadReplayConfiguration {
+	//! The query trace to replay
+	string trace_path;
+	//! SQL script run before the replay, e.g. to load the data and to choose the compaction policy
+	string init_path;
+	//! Statement with a single parameter that the key lookups of the trace execute
+	string lookup_query;
+	//! File the per-second statistics are written to (as CSV), stdout if empty
+	string csv_path;
+	//! Queries issued per second, 0 issues every query at its timestamp in the trace
+	double rate = 0;
+	//! Number of client threads, each with its own connection
+	idx_t clients = 1;
+	//! Number of threads of the database
+	idx_t threads = 1;
+};
+
+//! A query of a trace
+struct ReplayQuery {
+	//! When the query is due, relative to the start of the replay
+	int64_t offset_us;
+	//! Whether the query is a key lookup (that executes the lookup statement) or SQL
+	bool is_lookup;
+	//! The SQL or the key of the lookup
+	string text;
+};
+
+//! A query issued by a client
+struct ReplaySample {
+	//! When the query finished, relative to the start of the replay
+	int64_t finish_us;
+	//! The time from when the query was due until it finished, so a backlog of queries shows up as latency
+	int64_t latency_us;
+	bool error;
+};
+
+//! The statistics of one second of a replay
+struct ReplaySecond {
+	idx_t queries = 0;
+	idx_t errors = 0;
+	//! Latencies of the queries finished in this second, from the time they were due
+	vector<int64_t> latencies_us;
+	idx_t used_memory = 0;
+	//! Segments (un)compacted during this second
+	idx_t compactions = 0;
+	idx_t uncompactions = 0;
+};
+
+//! Replays a query trace on an in-memory database at a target rate with several client threads, and records the
+//! throughput, the latencies, the memory usage and the compaction events of every second as CSV. This allows
+//! comparing the adaptive compaction policies on the same (e.g. production) trace.
+class WorkloadReplay {
+public:
+	explicit WorkloadReplay(WorkloadReplayConfiguration config);
+
+	//! Read a trace. Every line holds a timestamp in milliseconds and a query, separated by a tab. A query is either
+	//! SQL or "LOOKUP <key>". Empty lines and lines starting with '#' are skipped.
+	static vector<ReplayQuery> ReadTrace(const string &path, double rate);
+
+	//! Run the init script, replay the trace and write the statistics
+	void Run();
+
+private:
+	//! Issue the queries assigned to this client until the trace is exhausted
+	void RunClient(Connection &conn, PreparedStatement *lookup, vector<ReplaySample> &samples);
+	void WriteStatistics(vector<ReplaySecond> &seconds);
+
+private:
+	WorkloadReplayConfiguration config;
+	DuckDB db;
+	vector<ReplayQuery> queries;
+	//! The next query of the trace that is issued by a client
+	atomic<idx_t> next_query;
+	std::chrono::steady_clock::time_point start;
+};
+
+} // namespace duckdb
@@ -15,8 +15,8 @@ using namespace duckdb;
 
 DUCKDB_BENCHMARK(DistributionChanging, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.adaptive_succinct_compression_enabled = false;
-	state->db.instance->config.succinct_enabled = true;
+	state->conn.Query("SET adaptive_succinct_compression_enabled=false");
+	state->conn.Query("SET succinct_enabled=true");
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 
 	Appender appender(state->conn, "t1");
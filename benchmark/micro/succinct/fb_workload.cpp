@@ -21,7 +21,7 @@ const size_t workload_step_size = 100;
 
 DUCKDB_BENCHMARK(FBWorkloadAdaptive, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.adaptive_succinct_compression_enabled = true;
+	state->conn.Query("SET adaptive_succinct_compression_enabled=true");
 	state->conn.Query("CREATE TABLE t1(i UBIGINT);");
 
 	auto user_ids = ParallelLoadData<uint64_t>(user_ids_filename);
@@ -204,7 +204,7 @@ FINISH_BENCHMARK(FBWorkloadSuccinct)
 
 DUCKDB_BENCHMARK(FBWorkload, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_enabled = false;
+	state->conn.Query("SET succinct_enabled=false");
 	state->conn.Query("CREATE TABLE t1(i UBIGINT);");
 
 	auto user_ids = ParallelLoadData<uint64_t>(user_ids_filename);
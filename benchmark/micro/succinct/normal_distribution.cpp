@@ -58,7 +58,7 @@ FINISH_BENCHMARK(SuccinctNormalDistribution)
 
 DUCKDB_BENCHMARK(SuccinctPaddedNormalDistribution, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_padded_to_next_byte_enabled = true;
+	state->conn.Query("SET succinct_padded_to_next_byte_enabled=true");
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 
 	Appender appender(state->conn, "t1");
@@ -104,7 +104,7 @@ FINISH_BENCHMARK(SuccinctPaddedNormalDistribution)
 
 DUCKDB_BENCHMARK(NonSuccinctNormalDistribution, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_enabled = false;
+	state->conn.Query("SET succinct_enabled=false");
 
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 	Appender appender(state->conn, "t1");
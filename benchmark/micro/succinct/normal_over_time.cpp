@@ -16,7 +16,7 @@ using namespace duckdb;
 
 DUCKDB_BENCHMARK(SuccinctNormalDistributionOverTime, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.adaptive_succinct_compression_enabled = true;
+	state->conn.Query("SET adaptive_succinct_compression_enabled=true");
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 
 	Appender appender(state->conn, "t1");
@@ -166,7 +166,7 @@ FINISH_BENCHMARK(SuccinctNotAdaptiveNormalDistributionOverTime)
 
 DUCKDB_BENCHMARK(NonSuccinctNormalDistributionOverTime, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_enabled = false;
+	state->conn.Query("SET succinct_enabled=false");
 
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 	Appender appender(state->conn, "t1");
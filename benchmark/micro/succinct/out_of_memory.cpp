@@ -51,7 +51,7 @@ FINISH_BENCHMARK(SuccinctScanOOM)
 
 DUCKDB_BENCHMARK(NonSuccinctScanOOM, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_enabled = false;
+	state->conn.Query("SET succinct_enabled=false");
 	state->conn.Query("PRAGMA memory_limit='1GB'");
 	state->conn.Query("CREATE TABLE t1(i INTEGER);");
 
@@ -131,7 +131,7 @@ FINISH_BENCHMARK(SuccinctZipfScanOOM)
 
 DUCKDB_BENCHMARK(NonSuccinctZipfScanOOM, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_enabled = false;
+	state->conn.Query("SET succinct_enabled=false");
 	state->conn.Query("PRAGMA memory_limit='1GB'");
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 
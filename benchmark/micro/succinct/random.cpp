@@ -45,7 +45,7 @@ FINISH_BENCHMARK(SuccinctRandomInsert)
 DUCKDB_BENCHMARK(SuccinctPaddedRandomInsert, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
 	srand((unsigned) time(nullptr));
-	state->db.instance->config.succinct_padded_to_next_byte_enabled = true;
+	state->conn.Query("SET succinct_padded_to_next_byte_enabled=true");
 	state->conn.Query("CREATE TABLE t1(i INTEGER);");
 
 	Appender appender(state->conn, "t1");
@@ -78,7 +78,7 @@ FINISH_BENCHMARK(SuccinctPaddedRandomInsert)
 DUCKDB_BENCHMARK(NonSuccinctRandomInsert, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
 	srand((unsigned) time(nullptr));
-	state->db.instance->config.succinct_enabled = false;
+	state->conn.Query("SET succinct_enabled=false");
 
 	state->conn.Query("CREATE TABLE t1(i INTEGER);");
 	Appender appender(state->conn, "t1");
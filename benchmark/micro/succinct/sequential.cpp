@@ -47,7 +47,7 @@ FINISH_BENCHMARK(SuccinctSequentialInsert)
 
 DUCKDB_BENCHMARK(SuccinctPaddedSequentialInsert, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_padded_to_next_byte_enabled = true;
+	state->conn.Query("SET succinct_padded_to_next_byte_enabled=true");
 	state->conn.Query("CREATE TABLE t1(i INTEGER);");
 
 	Appender appender(state->conn, "t1");
@@ -82,7 +82,7 @@ FINISH_BENCHMARK(SuccinctPaddedSequentialInsert)
 
 DUCKDB_BENCHMARK(NonSuccinctSequentialInsert, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_enabled = false;
+	state->conn.Query("SET succinct_enabled=false");
 	state->conn.Query("CREATE TABLE t1(i INTEGER);");
 
 	Appender appender(state->conn, "t1");
@@ -62,7 +62,7 @@ FINISH_BENCHMARK(SuccinctZipfDistribution)
 
 DUCKDB_BENCHMARK(SuccinctPaddedZipfDistribution, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_padded_to_next_byte_enabled = true;
+	state->conn.Query("SET succinct_padded_to_next_byte_enabled=true");
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 
 	Appender appender(state->conn, "t1");
@@ -106,7 +106,7 @@ FINISH_BENCHMARK(SuccinctPaddedZipfDistribution)
 
 DUCKDB_BENCHMARK(NonSuccinctZipfDistribution, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_enabled = false;
+	state->conn.Query("SET succinct_enabled=false");
 
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 	Appender appender(state->conn, "t1");
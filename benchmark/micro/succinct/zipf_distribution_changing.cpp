@@ -17,7 +17,7 @@ using namespace duckdb;
 
 DUCKDB_BENCHMARK(SuccinctZipfChangingOverTime, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.adaptive_succinct_compression_enabled = true;
+	state->conn.Query("SET adaptive_succinct_compression_enabled=true");
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 
 	Appender appender(state->conn, "t1");
@@ -95,8 +95,8 @@ FINISH_BENCHMARK(SuccinctZipfChangingOverTime)
 
 DUCKDB_BENCHMARK(NonSuccinctZipfChangingOverTime, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_enabled = false;
-	state->db.instance->config.adaptive_succinct_compression_enabled = false;
+	state->conn.Query("SET succinct_enabled=false");
+	state->conn.Query("SET adaptive_succinct_compression_enabled=false");
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 
 	Appender appender(state->conn, "t1");
@@ -174,8 +174,8 @@ FINISH_BENCHMARK(NonSuccinctZipfChangingOverTime)
 
 DUCKDB_BENCHMARK(SuccinctNotAdaptiveZipfChangingOverTime, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_enabled = true;
-	state->db.instance->config.adaptive_succinct_compression_enabled = false;
+	state->conn.Query("SET succinct_enabled=true");
+	state->conn.Query("SET adaptive_succinct_compression_enabled=false");
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 
 	Appender appender(state->conn, "t1");
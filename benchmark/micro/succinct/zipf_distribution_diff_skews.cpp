@@ -17,7 +17,7 @@ using namespace duckdb;
 
 DUCKDB_BENCHMARK(SuccinctZipfDifferentSkews, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.adaptive_succinct_compression_enabled = true;
+	state->conn.Query("SET adaptive_succinct_compression_enabled=true");
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 
 	Appender appender(state->conn, "t1");
@@ -112,7 +112,7 @@ FINISH_BENCHMARK(SuccinctZipfDifferentSkews)
 
 DUCKDB_BENCHMARK(SuccinctZipfNonAdaptiveDifferentSkews, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_enabled = true;
+	state->conn.Query("SET succinct_enabled=true");
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 
 	Appender appender(state->conn, "t1");
@@ -197,7 +197,7 @@ FINISH_BENCHMARK(SuccinctZipfNonAdaptiveDifferentSkews)
 
 DUCKDB_BENCHMARK(NonSuccinctZipfDifferentSkews, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_enabled = false;
+	state->conn.Query("SET succinct_enabled=false");
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 
 	Appender appender(state->conn, "t1");
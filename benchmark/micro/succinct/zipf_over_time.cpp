@@ -17,7 +17,7 @@ using namespace duckdb;
 
 DUCKDB_BENCHMARK(SuccinctZipfDistributionOverTime, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.adaptive_succinct_compression_enabled = true;
+	state->conn.Query("SET adaptive_succinct_compression_enabled=true");
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 
 	Appender appender(state->conn, "t1");
@@ -174,7 +174,7 @@ FINISH_BENCHMARK(SuccinctNotAdaptiveZipfDistributionOverTime)
 
 DUCKDB_BENCHMARK(NonSuccinctZipfDistributionOverTime, "[succinct]")
 void Load(DuckDBBenchmarkState *state) override {
-	state->db.instance->config.succinct_enabled = false;
+	state->conn.Query("SET succinct_enabled=false");
 
 	state->conn.Query("CREATE TABLE t1(i UINTEGER);");
 	Appender appender(state->conn, "t1");
@@ -0,0 +1,216 @@
+#include "workload_replay.hpp"
+
+#include "duckdb/catalog/catalog_entry/column_segment_catalog.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace duckdb;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+WorkloadReplay::WorkloadReplay(WorkloadReplayConfiguration config_p)
+    : config(move(config_p)), db(nullptr), next_query(0) {
+	if (config.clients == 0) {
+		throw InvalidInputException("The replay needs at least one client");
+	}
+	queries = ReadTrace(config.trace_path, config.rate);
+	for (auto &query : queries) {
+		if (query.is_lookup && config.lookup_query.empty()) {
+			throw InvalidInputException("The trace contains key lookups, but no lookup query was given");
+		}
+	}
+}
+
+vector<ReplayQuery> WorkloadReplay::ReadTrace(const string &path, double rate) {
+	std::ifstream trace(path);
+	if (!trace.good()) {
+		throw IOException("Could not open trace \"%s\"", path);
+	}
+	vector<ReplayQuery> result;
+	double first_timestamp = 0;
+	string line;
+	idx_t line_number = 0;
+	while (std::getline(trace, line)) {
+		line_number++;
+		StringUtil::Trim(line);
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+		auto separator = line.find('\t');
+		if (separator == string::npos) {
+			throw InvalidInputException("Line %llu of trace \"%s\" has no timestamp", line_number, path);
+		}
+		auto timestamp = Value(line.substr(0, separator)).DefaultCastAs(LogicalType::DOUBLE).GetValue<double>();
+		if (result.empty()) {
+			first_timestamp = timestamp;
+		}
+
+		ReplayQuery query;
+		query.text = line.substr(separator + 1);
+		StringUtil::Trim(query.text);
+		query.is_lookup = StringUtil::StartsWith(query.text, "LOOKUP ");
+		if (query.is_lookup) {
+			query.text = query.text.substr(strlen("LOOKUP "));
+			StringUtil::Trim(query.text);
+		}
+		if (rate > 0) {
+			// issue the queries at a fixed rate, in the order of the trace
+			query.offset_us = int64_t(result.size() * 1e6 / rate);
+		} else {
+			query.offset_us = MaxValue<int64_t>(int64_t((timestamp - first_timestamp) * 1e3), 0);
+		}
+		result.push_back(move(query));
+	}
+	// clients pick up the queries in the order they are due
+	std::stable_sort(result.begin(), result.end(), [](const ReplayQuery &a, const ReplayQuery &b) {
+		return a.offset_us < b.offset_us;
+	});
+	return result;
+}
+
+void WorkloadReplay::RunClient(Connection &conn, PreparedStatement *lookup, vector<ReplaySample> &samples) {
+	while (true) {
+		idx_t query_idx = next_query++;
+		if (query_idx >= queries.size()) {
+			return;
+		}
+		auto &query = queries[query_idx];
+		auto due = start + microseconds(query.offset_us);
+		std::this_thread::sleep_until(due);
+
+		unique_ptr<QueryResult> result;
+		if (query.is_lookup) {
+			vector<Value> values {Value(query.text)};
+			result = lookup->Execute(values, false);
+		} else {
+			result = conn.Query(query.text);
+		}
+		auto finish = steady_clock::now();
+
+		ReplaySample sample;
+		sample.finish_us = duration_cast<microseconds>(finish - start).count();
+		sample.latency_us = duration_cast<microseconds>(finish - due).count();
+		sample.error = result->HasError();
+		samples.push_back(sample);
+	}
+}
+
+void WorkloadReplay::Run() {
+	Connection init_conn(db);
+	auto result = init_conn.Query("PRAGMA threads=" + to_string(config.threads));
+	if (result->HasError()) {
+		result->ThrowError();
+	}
+	if (!config.init_path.empty()) {
+		std::ifstream init_file(config.init_path);
+		if (!init_file.good()) {
+			throw IOException("Could not open init script \"%s\"", config.init_path);
+		}
+		std::stringstream script;
+		script << init_file.rdbuf();
+		result = init_conn.Query(script.str());
+		if (result->HasError()) {
+			result->ThrowError("Init script failed: ");
+		}
+	}
+
+	// connect and prepare the lookups before the replay starts
+	vector<unique_ptr<Connection>> connections;
+	vector<unique_ptr<PreparedStatement>> lookups;
+	for (idx_t i = 0; i < config.clients; i++) {
+		connections.push_back(make_unique<Connection>(db));
+		if (config.lookup_query.empty()) {
+			lookups.push_back(nullptr);
+			continue;
+		}
+		auto lookup = connections.back()->Prepare(config.lookup_query);
+		if (lookup->HasError()) {
+			throw InvalidInputException("Could not prepare the lookup query: %s", lookup->GetError());
+		}
+		lookups.push_back(move(lookup));
+	}
+
+	auto &buffer_manager = BufferManager::GetBufferManager(*db.instance);
+	auto &segment_catalog = db.instance->GetColumnSegmentCatalog();
+	vector<ReplaySecond> seconds;
+	vector<vector<ReplaySample>> samples(config.clients);
+	vector<std::thread> clients;
+	atomic<idx_t> finished_clients(0);
+
+	start = steady_clock::now();
+	for (idx_t i = 0; i < config.clients; i++) {
+		clients.emplace_back([this, i, &connections, &lookups, &samples, &finished_clients]() {
+			RunClient(*connections[i], lookups[i].get(), samples[i]);
+			finished_clients++;
+		});
+	}
+	// sample the memory and the compaction counters once per second while the clients run
+	idx_t compactions = segment_catalog.GetCompactionCount();
+	idx_t uncompactions = segment_catalog.GetUncompactionCount();
+	do {
+		auto second_end = start + std::chrono::seconds(seconds.size() + 1);
+		while (finished_clients < config.clients && steady_clock::now() < second_end) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		ReplaySecond second;
+		second.used_memory = buffer_manager.GetUsedMemory();
+		idx_t current_compactions = segment_catalog.GetCompactionCount();
+		idx_t current_uncompactions = segment_catalog.GetUncompactionCount();
+		second.compactions = current_compactions - compactions;
+		second.uncompactions = current_uncompactions - uncompactions;
+		compactions = current_compactions;
+		uncompactions = current_uncompactions;
+		seconds.push_back(move(second));
+	} while (finished_clients < config.clients);
+	for (auto &client : clients) {
+		client.join();
+	}
+
+	// attribute the queries to the second they finished in
+	for (auto &client_samples : samples) {
+		for (auto &sample : client_samples) {
+			idx_t second_idx = MinValue<idx_t>(sample.finish_us / 1000000, seconds.size() - 1);
+			auto &second = seconds[second_idx];
+			second.queries++;
+			if (sample.error) {
+				second.errors++;
+			}
+			second.latencies_us.push_back(sample.latency_us);
+		}
+	}
+	WriteStatistics(seconds);
+}
+
+static int64_t GetPercentile(vector<int64_t> &sorted_latencies, double percentile) {
+	if (sorted_latencies.empty()) {
+		return 0;
+	}
+	return sorted_latencies[idx_t(percentile * (sorted_latencies.size() - 1))];
+}
+
+void WorkloadReplay::WriteStatistics(vector<ReplaySecond> &seconds) {
+	std::ofstream csv_file;
+	if (!config.csv_path.empty()) {
+		csv_file.open(config.csv_path);
+		if (!csv_file.good()) {
+			throw IOException("Could not open \"%s\" for writing", config.csv_path);
+		}
+	}
+	std::ostream &out = config.csv_path.empty() ? std::cout : csv_file;
+	out << "second,queries,errors,p50_latency_us,p99_latency_us,used_memory,compactions,uncompactions\n";
+	for (idx_t i = 0; i < seconds.size(); i++) {
+		auto &second = seconds[i];
+		std::sort(second.latencies_us.begin(), second.latencies_us.end());
+		out << i << "," << second.queries << "," << second.errors << "," << GetPercentile(second.latencies_us, 0.5)
+		    << "," << GetPercentile(second.latencies_us, 0.99) << "," << second.used_memory << ","
+		    << second.compactions << "," << second.uncompactions << "\n";
+	}
+	out.flush();
+}
@@ -37,8 +37,6 @@
 
 namespace duckdb {
 
-ColumnSegmentCatalog* Catalog::column_segment_catalog = new ColumnSegmentCatalog();
-
 Catalog::Catalog(AttachedDatabase &db)
     : schemas(make_unique<CatalogSet>(*this, make_unique<DefaultSchemaGenerator>(*this))),
       dependency_manager(make_unique<DependencyManager>(*this)), db(db) {}
@@ -64,16 +62,11 @@ void Catalog::Initialize(bool load_builtin) {
 		builtin.Initialize();
 	}
 
-	if (!column_segment_catalog->BackgroundCompactionEnabled() &&
-	    DBConfig::GetConfig(db.GetDatabase()).adaptive_succinct_compression_enabled) {
-	}
-	column_segment_catalog->EnableBackgroundThreadCompaction();
-
 	Verify();
 }
 
 ColumnSegmentCatalog *Catalog::GetColumnSegmentCatalog() {
-	return column_segment_catalog;
+	return &GetDatabase().GetColumnSegmentCatalog();
 }
 
 
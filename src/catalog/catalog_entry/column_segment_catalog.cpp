@@ -1,188 +1,820 @@
 #include "duckdb/catalog/catalog_entry/column_segment_catalog.hpp"
+#include "duckdb/common/profiler.hpp"
+#include "duckdb/common/succinct_primitives.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/parallel/task.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/table/column_segment.hpp"
+#include "duckdb/storage/table/segment_spill_file.hpp"
 #include <algorithm>
-#include <iostream>
-#include <thread>
 
 namespace duckdb {
 
-ColumnSegmentCatalog::ColumnSegmentCatalog():
-      statistics(), event_counter(0), background_thread_started(false),
-      background_compaction_enabled(false) {
+ColumnSegmentCatalog::ColumnSegmentCatalog(DatabaseInstance &db):
+      db(db), policy(AdaptiveCompactionPolicy::FIXED_RATIO), interval_ms(10000), compaction_ratio(0.90),
+      target_memory((idx_t)-1), decode_budget(0.05), heat_decay(0.5), scan_weight(0.1),
+      hysteresis_rounds(2), compaction_threads(1),
+      compactions(0), uncompactions(0), avoided_transitions(0), compaction_time_ns(0), uncompaction_time_ns(0),
+      rounds(0), reclaimed_segments(0), reclaimed_memory(0), delta_appends(0), delta_merges(0),
+      reclaiming(false), reclaimable_segments(0), spillable_segments(0), spills(0),
+      spilled_memory(0), spill_loads(0), prefetches(0), spill_enabled(false), perf_events_enabled(false),
+      decode_costs_calibrated(false),
+      active_tasks(0),
+      queued_tasks(0), queued_prefetches(0), shutting_down(false), background_thread_started(false), background_compaction_enabled(false),
+      adaptive_compaction_enabled(false) {
+}
+
+ColumnSegmentCatalog::~ColumnSegmentCatalog() {
+	Shutdown();
+}
+
+void ColumnSegmentCatalog::Configure(DBConfig &config) {
+	{
+		lock_guard<mutex> guard(options_lock);
+		policy = config.adaptive_compaction_policy;
+		interval_ms = config.adaptive_compaction_interval;
+		compaction_ratio = config.adaptive_compaction_ratio;
+		target_memory = config.adaptive_compaction_target_memory;
+		decode_budget = config.adaptive_compaction_decode_budget;
+		heat_decay = config.adaptive_compaction_heat_decay;
+		scan_weight = config.adaptive_compaction_scan_weight;
+		hysteresis_rounds = config.adaptive_compaction_hysteresis_rounds;
+		compaction_threads = config.adaptive_compaction_threads;
+		adaptive_compaction_enabled = config.adaptive_succinct_compression_enabled;
+		perf_events_enabled = config.perf_events_enabled;
+		spill_enabled = config.adaptive_compaction_spill_enabled;
+	}
+	options_changed.notify_all();
+	if (config.adaptive_succinct_compression_enabled) {
+		// the thread is only started once adaptive compaction is turned on, it then waits while it is turned off
+		EnableBackgroundThreadCompaction();
+	}
+}
+
+//! The state of the SegmentTransitionScope of the current thread
+static thread_local ColumnSegment *transition_segment = nullptr;
+static thread_local bool transition_holds_registry_lock = false;
+
+SegmentTransitionScope::SegmentTransitionScope(ColumnSegment *segment, bool holds_registry_lock)
+    : previous_segment(transition_segment), previous_holds_registry_lock(transition_holds_registry_lock) {
+	transition_segment = segment;
+	transition_holds_registry_lock = transition_holds_registry_lock || holds_registry_lock;
+}
+
+SegmentTransitionScope::~SegmentTransitionScope() {
+	transition_segment = previous_segment;
+	transition_holds_registry_lock = previous_holds_registry_lock;
+}
+
+ColumnSegment *SegmentTransitionScope::CurrentSegment() {
+	return transition_segment;
+}
+
+bool SegmentTransitionScope::HoldsRegistryLock() {
+	return transition_holds_registry_lock;
 }
 
 void ColumnSegmentCatalog::EnableBackgroundThreadCompaction() {
-	if (!background_compaction_enabled) {
-		background_compaction_enabled = true;
+	bool expected = false;
+	if (!shutting_down && background_compaction_enabled.compare_exchange_strong(expected, true)) {
 		//std::cout << "START BACKGROUND COMPACTION at " << this << std::endl;
 
 		background_thread_started = true;
-		std::thread t(&ColumnSegmentCatalog::CompressLowestKSegments, this);
-		t.detach();
+		background_thread = make_unique<thread>(&ColumnSegmentCatalog::CompressLowestKSegments, this);
+	}
+}
+
+void ColumnSegmentCatalog::Shutdown() {
+	{
+		// set under the options lock so the background thread cannot miss the wake up
+		lock_guard<mutex> guard(options_lock);
+		shutting_down = true;
+	}
+	options_changed.notify_all();
+	if (background_thread) {
+		background_thread->join();
+		background_thread.reset();
 	}
+	// the producer refers to the queue of the scheduler, which is destroyed before the catalog
+	lock_guard<mutex> guard(spill_lock);
+	prefetch_producer.reset();
+}
+
+ColumnSegmentCatalogShard &ColumnSegmentCatalog::GetShard(ColumnSegment *segment) {
+	// segments are heap allocated: drop the low bits that are identical due to alignment
+	return shards[(uintptr_t(segment) >> 6) % NUM_SHARDS];
 }
 
 void ColumnSegmentCatalog::AddColumnSegment(ColumnSegment* segment) {
-	if (segment->is_data_segment) {
-		statistics[segment] = AccessStatistics{/* num_reads= */ 0};
+	if (!segment->is_data_segment) {
+		return;
 	}
+	auto &shard = GetShard(segment);
+	lock_guard<mutex> guard(shard.lock);
+	shard.segments.insert(segment);
 
 	//std::cout << "Add segment " << &segment << " to access statistics" << std::endl;
 	//std::cout << "This pointer in AddColumnSegment: " << this << std::endl;
 }
 
 void ColumnSegmentCatalog::RemoveColumnSegment(ColumnSegment* segment) {
-	statistics.erase(segment);
+	auto &shard = GetShard(segment);
+	unique_lock<mutex> guard(shard.lock);
+	shard.segments.erase(segment);
+	// a compaction or prefetch task that pinned the segment may still work on it
+	shard.unpinned.wait(guard, [&]() { return segment->catalog_pins == 0; });
 }
 
+//! Keeps a registered segment alive after the lock of its registry shard is released, so that other segments of the
+//! shard can be registered and destroyed while it is transcoded or loaded. Created while holding the shard lock.
+class SegmentPin {
+public:
+	SegmentPin(ColumnSegmentCatalogShard &shard, ColumnSegment *segment) : shard(shard), segment(segment) {
+		segment->catalog_pins++;
+	}
+	~SegmentPin() {
+		{
+			lock_guard<mutex> guard(shard.lock);
+			segment->catalog_pins--;
+		}
+		shard.unpinned.notify_all();
+	}
+
+private:
+	ColumnSegmentCatalogShard &shard;
+	ColumnSegment *segment;
+};
+
 void ColumnSegmentCatalog::AddReadAccess(ColumnSegment* segment) {
 	if (segment == nullptr || !segment->is_data_segment) {
 		//std::cout << "Add read access but early return" << std::endl;
 		return;
 	}
 
-	if (statistics.find(segment) == statistics.end()) {
-		statistics[segment] = AccessStatistics{/* num_reads= */ 1};
-		/*
-		if (segment->succinct_possible) {
-			std::cout << "SHOULD NEVER HAPPEN NOW???" << std::endl;
+	segment->access_statistics.num_reads.fetch_add(1, std::memory_order_relaxed);
+}
+
+string SegmentKernelToString(SegmentKernel kernel) {
+	switch (kernel) {
+	case SegmentKernel::SCAN:
+		return "scan";
+	case SegmentKernel::FILTER:
+		return "filter";
+	case SegmentKernel::FETCH:
+		return "fetch";
+	case SegmentKernel::COMPACTION:
+		return "compaction";
+	case SegmentKernel::UNCOMPACTION:
+		return "uncompaction";
+	case SegmentKernel::AGGREGATE:
+		return "aggregate";
+	default:
+		throw InternalException("Unrecognized segment kernel");
+	}
+}
+
+void ColumnSegmentCatalog::RecordKernel(SegmentKernel kernel, uint8_t width, idx_t values,
+                                        const PerfEventCounters &counters) {
+	D_ASSERT(idx_t(kernel) < KERNEL_COUNT && width <= 64);
+	auto &entry = kernel_counters[idx_t(kernel)][width];
+	entry.calls.fetch_add(1, std::memory_order_relaxed);
+	entry.values.fetch_add(values, std::memory_order_relaxed);
+	entry.cycles.fetch_add(counters.cycles, std::memory_order_relaxed);
+	entry.instructions.fetch_add(counters.instructions, std::memory_order_relaxed);
+	entry.llc_misses.fetch_add(counters.llc_misses, std::memory_order_relaxed);
+	entry.branch_misses.fetch_add(counters.branch_misses, std::memory_order_relaxed);
+}
+
+vector<SegmentKernelInfo> ColumnSegmentCatalog::GetKernelCounters() {
+	vector<SegmentKernelInfo> result;
+	for (idx_t kernel = 0; kernel < KERNEL_COUNT; kernel++) {
+		for (idx_t width = 0; width <= 64; width++) {
+			auto &entry = kernel_counters[kernel][width];
+			SegmentKernelInfo info;
+			info.calls = entry.calls.load(std::memory_order_relaxed);
+			if (info.calls == 0) {
+				continue;
+			}
+			info.kernel = SegmentKernel(kernel);
+			info.width = uint8_t(width);
+			info.values = entry.values.load(std::memory_order_relaxed);
+			info.counters.cycles = entry.cycles.load(std::memory_order_relaxed);
+			info.counters.instructions = entry.instructions.load(std::memory_order_relaxed);
+			info.counters.llc_misses = entry.llc_misses.load(std::memory_order_relaxed);
+			info.counters.branch_misses = entry.branch_misses.load(std::memory_order_relaxed);
+			result.push_back(info);
 		}
-		 */
-	} else {
-		statistics[segment].num_reads++;
-		event_counter++;
 	}
+	return result;
 }
 
-void ColumnSegmentCatalog::CompactAllSegments() {
-	std::cout << "Num segments: " << statistics.size() << std::endl;
-	for (auto iter = statistics.begin(); iter != statistics.end(); ++iter) {
-		iter->first->Compact();
+void ColumnSegmentCatalog::AddScanAccess(ColumnSegment* segment) {
+	if (segment == nullptr || !segment->is_data_segment) {
+		return;
 	}
-	//Print();
+
+	segment->access_statistics.num_scans.fetch_add(1, std::memory_order_relaxed);
 }
 
-void ColumnSegmentCatalog::CompressLowestKSegments() {
-	double compression_rate = 0.90;
-	//bool finished = false;
-	//size_t i = 0;
-	//std::cout << "Start background compaction" << std::endl;
+vector<AccessStatisticsSnapshot> ColumnSegmentCatalog::SnapshotStatistics(idx_t &used_memory) {
+	vector<AccessStatisticsSnapshot> result;
+	used_memory = BufferManager::GetBufferManager(db).GetUsedMemory();
+	for (auto &shard : shards) {
+		lock_guard<mutex> guard(shard.lock);
+		for (auto segment : shard.segments) {
+			AccessStatisticsSnapshot snapshot;
+			snapshot.heat = segment->access_statistics.heat;
+			// the width the segment gets at its current heat. Segments that are appended to or compacted right now
+			// are left to the next round, their statistics change while they are read.
+			bool pad_to_byte = GetPadToByte(snapshot.heat);
+			if (!segment->TryEstimateSuccinctSize(pad_to_byte, snapshot.width, snapshot.compacted_size)) {
+				continue;
+			}
+			snapshot.segment = segment;
+			snapshot.num_reads = segment->access_statistics.num_reads.load(std::memory_order_relaxed);
+			snapshot.num_scans = segment->access_statistics.num_scans.load(std::memory_order_relaxed);
+			snapshot.compactable = segment->succinct_possible;
+			snapshot.compacted = segment->IsBitCompressed();
+			snapshot.count = segment->count;
+			snapshot.uncompacted_size = segment->SegmentSize();
+			result.push_back(snapshot);
+		}
+	}
+	return result;
+}
 
-	while (true) {
-		std::this_thread::sleep_for(std::chrono::seconds(10));
-		std::cout << "COMPRESS " << statistics.size() << " segments" << std::endl;
+vector<ColumnSegmentInfo> ColumnSegmentCatalog::GetSegmentInfo() {
+	vector<ColumnSegmentInfo> result;
+	for (auto &shard : shards) {
+		lock_guard<mutex> guard(shard.lock);
+		for (auto segment : shard.segments) {
+			ColumnSegmentInfo info;
+			info.segment_id = idx_t(uintptr_t(segment));
+			info.type = segment->type;
+			info.row_start = segment->start;
+			info.count = segment->count;
+			info.compactable = segment->succinct_possible;
+			info.compacted = false;
+			info.encoding = SuccinctEncoding::FRAME_OF_REFERENCE;
+			info.width = 0;
+			info.frame_of_reference = 0;
+			info.data_size = segment->GetDataSize();
+			info.segment_size = segment->SegmentSize();
+			info.num_reads = segment->access_statistics.num_reads.load(std::memory_order_relaxed);
+			info.num_scans = segment->access_statistics.num_scans.load(std::memory_order_relaxed);
+			info.heat = segment->access_statistics.heat;
+			info.last_transition = timestamp_t(0);
+			info.spilled = false;
+			auto representation = segment->GetRepresentation();
+			if (representation) {
+				info.compacted = representation->compacted;
+				info.encoding = representation->encoding;
+				info.width = representation->GetWidth();
+				info.frame_of_reference = representation->frame_of_reference;
+				info.last_transition = representation->published_at;
+				info.spilled = representation->spilled;
+			}
+			result.push_back(move(info));
+		}
+	}
+	return result;
+}
 
-		/*
-		if (event_counter < 50000) {
+void ColumnSegmentCatalog::CompactAllSegments() {
+	for (auto &shard : shards) {
+		lock_guard<mutex> guard(shard.lock);
+		for (auto segment : shard.segments) {
+			SegmentTransitionScope transition(segment, true);
+			segment->Compact();
+		}
+	}
+}
+
+idx_t ColumnSegmentCatalog::ReclaimMemory(idx_t required_memory) {
+	if (SegmentTransitionScope::HoldsRegistryLock()) {
+		// the memory is allocated by a compaction round or by another reclaim
+		return 0;
+	}
+	if (reclaimable_segments == 0 && (spillable_segments == 0 || !SpillEnabled())) {
+		// every segment is compacted without an uncompressed block: the buffer manager evicts blocks instead
+		return 0;
+	}
+	bool expected = false;
+	if (!reclaiming.compare_exchange_strong(expected, true)) {
+		// another thread is reclaiming, this one evicts blocks instead
+		return 0;
+	}
+
+	// The caller may hold the lock of a block that the thread of a locked shard waits for: shards are only tried,
+	// never waited for.
+	vector<AccessStatisticsSnapshot> segments;
+	for (auto &shard : shards) {
+		unique_lock<mutex> guard(shard.lock, std::try_to_lock);
+		if (!guard.owns_lock()) {
 			continue;
 		}
-		*/
-
-		idx_t curr_counter{event_counter};
-		std::vector<std::pair<ColumnSegment*, AccessStatistics>> v(statistics.begin(), statistics.end());
-		std::sort(v.begin(), v.end(),
-				  [](std::pair<ColumnSegment*, AccessStatistics>& left,
-					 std::pair<ColumnSegment*, AccessStatistics>& right) {
-					  return left.second < right.second;
-				  });
-
-		//Print();
-
-		float cum_sum = 0;
-		curr_counter = v.size();
-		for (auto iter = v.begin(); iter != v.end(); iter++) {
-			cum_sum += 1;
-			//cum_sum += iter->second.num_reads;
-
-			if (cum_sum / curr_counter < compression_rate) {
-				//! Compact all the least accessed segments with a ratio of #compression_rate.
-				//std::cout << "Before compact" << std::endl;
-				iter->first->Compact();
-				//std::cout << "After compact" << std::endl;
-			} else {
-				//! Uncompact / leave uncompressed all frequently accessed segments.
-				//std::cout << "Before uncompact" << std::endl;
-				iter->first->Uncompact();
-				//std::cout << "After uncompact" << std::endl;
+		for (auto segment : shard.segments) {
+			if (!segment->succinct_possible || segment == SegmentTransitionScope::CurrentSegment()) {
+				continue;
 			}
+			AccessStatisticsSnapshot snapshot;
+			snapshot.segment = segment;
+			snapshot.num_reads = segment->access_statistics.num_reads.load(std::memory_order_relaxed);
+			snapshot.num_scans = segment->access_statistics.num_scans.load(std::memory_order_relaxed);
+			snapshot.heat = segment->access_statistics.heat;
+			snapshot.compacted = segment->IsBitCompressed();
+			segments.push_back(snapshot);
+		}
+	}
+	// compacted segments only need to drop their uncompressed block, the others are compacted coldest first
+	std::sort(segments.begin(), segments.end(),
+	          [](const AccessStatisticsSnapshot &a, const AccessStatisticsSnapshot &b) {
+		          if (a.compacted != b.compacted) {
+			          return a.compacted;
+		          }
+		          if (a.heat != b.heat) {
+			          return a.heat < b.heat;
+		          }
+		          return a.num_reads < b.num_reads;
+	          });
+
+	idx_t freed_memory = 0;
+	for (auto &entry : segments) {
+		if (freed_memory >= required_memory) {
+			break;
+		}
+		// holding the shard lock keeps the segment alive
+		auto &shard = GetShard(entry.segment);
+		unique_lock<mutex> guard(shard.lock, std::try_to_lock);
+		if (!guard.owns_lock() || shard.segments.find(entry.segment) == shard.segments.end()) {
+			continue;
+		}
+		SegmentTransitionScope transition(entry.segment, true);
+		idx_t freed;
+		try {
+			freed = entry.segment->ReclaimMemory();
+		} catch (OutOfMemoryException &) {
+			// e.g. the block of the segment was spilled and there is no memory to load it for the compaction
+			continue;
+		}
+		if (freed > 0) {
+			reclaimed_segments++;
+			freed_memory += freed;
+		}
+	}
+	if (freed_memory < required_memory && SpillEnabled()) {
+		// all segments are compacted: move the coldest ones to the spill file
+		for (auto &entry : segments) {
+			if (freed_memory >= required_memory) {
+				break;
+			}
+			auto &shard = GetShard(entry.segment);
+			unique_lock<mutex> guard(shard.lock, std::try_to_lock);
+			if (!guard.owns_lock() || shard.segments.find(entry.segment) == shard.segments.end()) {
+				continue;
+			}
+			SegmentTransitionScope transition(entry.segment, true);
+			idx_t freed;
+			try {
+				freed = entry.segment->Spill();
+			} catch (std::exception &) {
+				// e.g. the temporary directory is full
+				continue;
+			}
+			if (freed > 0) {
+				reclaimed_segments++;
+				freed_memory += freed;
+			}
+		}
+	}
+	reclaimed_memory += freed_memory;
+	reclaiming = false;
+	return freed_memory;
+}
+
+shared_ptr<SegmentSpillFile> ColumnSegmentCatalog::GetSpillFile() {
+	lock_guard<mutex> guard(spill_lock);
+	if (spill_file) {
+		return spill_file;
+	}
+	auto &temp_directory = BufferManager::GetBufferManager(db).GetTemporaryDirectory();
+	if (temp_directory.empty()) {
+		return nullptr;
+	}
+	auto &fs = FileSystem::GetFileSystem(db);
+	if (!fs.DirectoryExists(temp_directory)) {
+		fs.CreateDirectory(temp_directory);
+	}
+	// several database instances may share the temporary directory
+	auto file_name = "duckdb_segment_spill-" + to_string(uintptr_t(this)) + ".tmp";
+	spill_file = make_shared<SegmentSpillFile>(db, fs.JoinPath(temp_directory, file_name));
+	return spill_file;
+}
+
+idx_t ColumnSegmentCatalog::GetSpillFileSize() {
+	lock_guard<mutex> guard(spill_lock);
+	return spill_file ? spill_file->GetFileSize() : 0;
+}
 
-			// Reset statistics to store only access patterns since last compacting iteration.
-			statistics[iter->first].num_reads = 0;
-			//iter->second.num_reads = 0;
+//! Loads a spilled segment ahead of the scan that reads it next
+class SegmentPrefetchTask : public Task {
+public:
+	SegmentPrefetchTask(ColumnSegmentCatalog &catalog, ColumnSegment *segment) : catalog(catalog), segment(segment) {
+	}
+
+	ColumnSegmentCatalog &catalog;
+	ColumnSegment *segment;
+
+public:
+	TaskExecutionResult Execute(TaskExecutionMode mode) override {
+		catalog.queued_prefetches--;
+		// the pin keeps the segment alive, the other segments of its shard do not wait for the read of the spill file
+		auto &shard = catalog.GetShard(segment);
+		unique_ptr<SegmentPin> pin;
+		{
+			lock_guard<mutex> guard(shard.lock);
+			if (catalog.shutting_down || shard.segments.find(segment) == shard.segments.end()) {
+				return TaskExecutionResult::TASK_FINISHED;
+			}
+			pin = make_unique<SegmentPin>(shard, segment);
 		}
-		event_counter = 0;
+		SegmentTransitionScope transition(segment);
+		try {
+			if (segment->IsSpilled()) {
+				segment->LoadSpilled();
+				catalog.prefetches++;
+			}
+		} catch (std::exception &) {
+			// the scan loads the segment itself and reports the error
+		}
+		segment->prefetch_scheduled = false;
+		return TaskExecutionResult::TASK_FINISHED;
+	}
+};
 
-		//std::cout << "\nFINISHED COMPACTION ROUND\n" << std::endl;
-		//std::cout << "Num segments: " << v.size() << std::endl;
+void ColumnSegmentCatalog::PrefetchSegment(ColumnSegment *segment) {
+	auto &scheduler = TaskScheduler::GetScheduler(db);
+	if (scheduler.NumberOfThreads() <= 1) {
+		// no other thread would load the segment before the scan gets there
+		return;
+	}
+	lock_guard<mutex> guard(spill_lock);
+	if (shutting_down) {
+		return;
+	}
+	bool expected = false;
+	if (!segment->prefetch_scheduled.compare_exchange_strong(expected, true)) {
+		return;
 	}
+	if (!prefetch_producer) {
+		prefetch_producer = scheduler.CreateProducer();
+	}
+	queued_prefetches++;
+	scheduler.ScheduleTask(*prefetch_producer, make_unique<SegmentPrefetchTask>(*this, segment));
+}
+
+void ColumnSegmentCatalog::CalibrateDecodeCosts() {
+	// decode the same buffer at every width and keep the fastest of a few runs to filter out noise
+	static constexpr const idx_t CALIBRATION_COUNT = 16 * STANDARD_VECTOR_SIZE;
+	static constexpr const idx_t CALIBRATION_RUNS = 5;
+	vector<uint64_t> packed(CALIBRATION_COUNT + 1, 0x5555555555555555ULL);
+	vector<uint64_t> target(CALIBRATION_COUNT);
+
+	Profiler profiler;
+	double copy_time = NumericLimits<double>::Maximum();
+	for (idx_t run = 0; run < CALIBRATION_RUNS; run++) {
+		profiler.Start();
+		memcpy(target.data(), packed.data(), CALIBRATION_COUNT * sizeof(uint64_t));
+		profiler.End();
+		copy_time = MinValue<double>(copy_time, profiler.Elapsed());
+	}
+
+	decode_cost_ns[0] = 0;
+	for (uint8_t width = 1; width <= 64; width++) {
+		double decode_time = NumericLimits<double>::Maximum();
+		for (idx_t run = 0; run < CALIBRATION_RUNS; run++) {
+			profiler.Start();
+			SuccinctPrimitives::UnPackBuffer<uint64_t>(target.data(), packed.data(), 0, CALIBRATION_COUNT, width, 0);
+			profiler.End();
+			decode_time = MinValue<double>(decode_time, profiler.Elapsed());
+		}
+		decode_cost_ns[width] = MaxValue<double>(decode_time - copy_time, 0) * 1e9 / CALIBRATION_COUNT;
+	}
+	decode_costs_calibrated = true;
+}
 
-	std::cout << "\n\n\n#####AFTER WHILE TRUE LOOP??######\n\n\n" << std::endl;
+vector<bool> ColumnSegmentCatalog::ChooseSegmentsFixedRatio(vector<AccessStatisticsSnapshot> &segments,
+                                                            double compaction_ratio) {
+	std::sort(segments.begin(), segments.end());
 
-	//Print();
+	vector<bool> compact(segments.size());
+	float cum_sum = 0;
+	idx_t curr_counter = segments.size();
+	for (idx_t i = 0; i < segments.size(); i++) {
+		cum_sum += 1;
+		//cum_sum += segments[i].num_reads;
 
-	while (true && false) {
-		//break;
-		Print();
-		std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+		//! Compact all the least accessed segments with a ratio of #compaction_ratio, leave uncompressed all
+		//! frequently accessed segments.
+		compact[i] = cum_sum / curr_counter < compaction_ratio;
 	}
+	return compact;
 }
 
-size_t ColumnSegmentCatalog::GetTotalDataSize() {
-	size_t data_size = 0;
-	for (auto iter = statistics.begin(); iter != statistics.end(); ++iter) {
-		data_size += iter->first->GetDataSize();
+vector<bool> ColumnSegmentCatalog::ChooseSegmentsCostModel(vector<AccessStatisticsSnapshot> &segments,
+                                                           idx_t used_memory, idx_t target_memory,
+                                                           double decode_budget_ns) {
+	struct Candidate {
+		idx_t index;
+		//! Bytes saved by keeping the segment compacted
+		idx_t benefit;
+		//! Expected additional decode time (in ns) per round when the segment is compacted
+		double decode_cost;
+	};
+
+	// the memory that would be in use if no segment was compacted
+	idx_t projected_memory = used_memory;
+	vector<Candidate> candidates;
+	for (idx_t i = 0; i < segments.size(); i++) {
+		auto &segment = segments[i];
+		if (!segment.compactable || segment.compacted_size >= segment.uncompacted_size) {
+			continue;
+		}
+		Candidate candidate;
+		candidate.index = i;
+		candidate.benefit = segment.uncompacted_size - segment.compacted_size;
+		// every read decodes at most one vector of the segment
+		candidate.decode_cost = segment.heat * MinValue<idx_t>(segment.count, STANDARD_VECTOR_SIZE) *
+		                        decode_cost_ns[segment.width];
+		if (segment.compacted) {
+			projected_memory += candidate.benefit;
+		}
+		candidates.push_back(candidate);
 	}
-	return data_size;
+
+	// cheapest saved bytes first
+	std::sort(candidates.begin(), candidates.end(), [](const Candidate &left, const Candidate &right) {
+		auto left_cost = left.decode_cost / left.benefit;
+		auto right_cost = right.decode_cost / right.benefit;
+		if (left_cost != right_cost) {
+			return left_cost < right_cost;
+		}
+		return left.benefit > right.benefit;
+	});
+
+	vector<bool> compact(segments.size(), false);
+	double spent_decode_ns = 0;
+	for (auto &candidate : candidates) {
+		// the decayed heat of a segment that was ever read only reaches 0 by underflow, after hundreds of rounds
+		bool cold = segments[candidate.index].heat < COLD_SEGMENT_HEAT;
+		bool over_target = projected_memory > target_memory;
+		if (cold || (over_target && spent_decode_ns + candidate.decode_cost <= decode_budget_ns)) {
+			compact[candidate.index] = true;
+			projected_memory -= candidate.benefit;
+			spent_decode_ns += candidate.decode_cost;
+		}
+	}
+	return compact;
 }
 
+//! (Un)compacts a range of the segments of a compaction round. The task stops early when queries are waiting for a
+//! thread and hands the rest of its range back to the background thread, which schedules it again later.
+class SegmentCompactionTask : public Task {
+public:
+	SegmentCompactionTask(ColumnSegmentCatalog &catalog, vector<AccessStatisticsSnapshot> &segments,
+	                      const vector<bool> &compact, idx_t start, idx_t end, idx_t hysteresis_rounds)
+	    : catalog(catalog), segments(segments), compact(compact), start(start), end(end),
+	      hysteresis_rounds(hysteresis_rounds) {
+	}
+
+	ColumnSegmentCatalog &catalog;
+	vector<AccessStatisticsSnapshot> &segments;
+	const vector<bool> &compact;
+	idx_t start;
+	idx_t end;
+	idx_t hysteresis_rounds;
+
+public:
+	TaskExecutionResult Execute(TaskExecutionMode mode) override {
+		catalog.queued_tasks--;
+		idx_t i = start;
+		for (; i < end && !catalog.shutting_down; i++) {
+			if (i > start && catalog.ForegroundTasksWaiting()) {
+				break;
+			}
+			catalog.ApplyDecision(segments[i], compact[i], hysteresis_rounds);
+		}
+		catalog.FinishCompactionTask(i, catalog.shutting_down ? i : end);
+		return TaskExecutionResult::TASK_FINISHED;
+	}
+};
 
-void ColumnSegmentCatalog::Print() {
-	idx_t curr_counter{event_counter};
-	std::vector<std::pair<ColumnSegment*, AccessStatistics>> v(statistics.begin(), statistics.end());
-	std::sort(v.begin(), v.end(),
-			  [](std::pair<ColumnSegment*, AccessStatistics>& left,
-				 std::pair<ColumnSegment*, AccessStatistics>& right) {
-				  return left.second < right.second;
-			  });
+void ColumnSegmentCatalog::CompressLowestKSegments() {
+	while (true) {
+		AdaptiveCompactionPolicy current_policy;
+		idx_t current_interval_ms;
+		double current_ratio;
+		idx_t current_target_memory;
+		double current_decode_budget;
+		double current_heat_decay;
+		double current_scan_weight;
+		idx_t current_hysteresis_rounds;
+		idx_t current_threads;
+		{
+			std::unique_lock<mutex> guard(options_lock);
+			// sleep for the configured interval; Configure() wakes us up so that a changed interval applies at once
+			auto round_start = std::chrono::steady_clock::now();
+			while (!shutting_down &&
+			       options_changed.wait_until(guard, round_start + std::chrono::milliseconds(interval_ms)) !=
+			           std::cv_status::timeout) {
+			}
+			if (shutting_down) {
+				return;
+			}
+			if (!adaptive_compaction_enabled) {
+				// the segments compact themselves, the reads are folded into their heat once this is enabled again
+				continue;
+			}
+			current_policy = policy;
+			current_interval_ms = interval_ms;
+			current_ratio = compaction_ratio;
+			current_target_memory = target_memory;
+			current_decode_budget = decode_budget;
+			current_heat_decay = heat_decay;
+			current_scan_weight = scan_weight;
+			current_hysteresis_rounds = hysteresis_rounds;
+			current_threads = compaction_threads;
+		}
 
-	size_t segment_sizes = 0;
-	size_t compressed_size = 0;
-	size_t succinct_size = 0;
+		idx_t used_memory;
+		auto v = SnapshotStatistics(used_memory);
 
-	float cum_sum = 0.0;
-	for (auto& curr : v) {
-		cum_sum += curr.second.num_reads;
-		if (cum_sum == 0.0) {
+		// fold the reads of this round into the decayed heat of every segment, scans only count with their weight
+		for (auto &entry : v) {
+			double reads = entry.num_reads + current_scan_weight * entry.num_scans;
+			entry.heat = current_heat_decay * entry.heat + (1 - current_heat_decay) * reads;
+		}
+
+		vector<bool> compact;
+		if (current_policy == AdaptiveCompactionPolicy::COST_MODEL) {
+			if (!decode_costs_calibrated) {
+				CalibrateDecodeCosts();
+			}
+			double decode_budget_ns = current_decode_budget * current_interval_ms * 1e6;
+			compact = ChooseSegmentsCostModel(v, used_memory, current_target_memory, decode_budget_ns);
+		} else {
+			compact = ChooseSegmentsFixedRatio(v, current_ratio);
+		}
+
+		RunCompactionRound(v, compact, current_hysteresis_rounds, current_threads);
+		rounds++;
+	}
+}
+
+void ColumnSegmentCatalog::RunCompactionRound(vector<AccessStatisticsSnapshot> &segments, const vector<bool> &compact,
+                                              idx_t hysteresis_rounds, idx_t thread_budget) {
+	auto &scheduler = TaskScheduler::GetScheduler(db);
+	auto producer = scheduler.CreateProducer();
+	thread_budget = MinValue<idx_t>(thread_budget, scheduler.NumberOfThreads());
+
+	{
+		lock_guard<mutex> guard(round_lock);
+		pending_ranges.clear();
+		// the last range is handed out first
+		for (idx_t start = segments.size(); start > 0;) {
+			idx_t end = start;
+			start -= MinValue<idx_t>(start, SEGMENTS_PER_TASK);
+			pending_ranges.emplace_back(start, end);
+		}
+	}
+
+	while (true) {
+		{
+			lock_guard<mutex> guard(round_lock);
+			if (shutting_down) {
+				pending_ranges.clear();
+			}
+			// back-pressure: no new compaction work is handed out while queries are waiting for a thread
+			while (!pending_ranges.empty() && active_tasks < thread_budget && !ForegroundTasksWaiting()) {
+				auto range = pending_ranges.back();
+				pending_ranges.pop_back();
+				active_tasks++;
+				queued_tasks++;
+				scheduler.ScheduleTask(*producer, make_unique<SegmentCompactionTask>(*this, segments, compact, range.first,
+				                                                                     range.second, hysteresis_rounds));
+			}
+			if (pending_ranges.empty() && active_tasks == 0) {
+				// no task can reference the segments of this round anymore
+				return;
+			}
+		}
+
+		// work on the tasks of the round as well, so that it makes progress without any scheduler threads
+		unique_ptr<Task> task;
+		if ((shutting_down || !ForegroundTasksWaiting()) && scheduler.GetTaskFromProducer(*producer, task)) {
+			task->Execute(TaskExecutionMode::PROCESS_ALL);
 			continue;
 		}
+		unique_lock<mutex> guard(round_lock);
+		round_finished.wait_for(guard, std::chrono::milliseconds(1));
+	}
+}
+
+SuccinctEncoding ColumnSegmentCatalog::GetMaximumEncoding(double heat) {
+	// FRAME_OF_REFERENCE decodes every value on its own; the others trade decode time for space
+	return heat < COLD_SEGMENT_HEAT ? SuccinctEncoding::DELTA : SuccinctEncoding::FRAME_OF_REFERENCE;
+}
 
-		std::cout << curr.first << ": "
-		          << curr.second.num_reads << "/" << curr_counter
-		          << ", compacted: "  << curr.first->IsBitCompressed()
-		          << ", cum ratio: " << cum_sum / curr_counter
-		          << ", size: " << curr.first->GetDataSize()
-		          << ", ratio: " << double(curr.first->GetDataSize()) / curr.first->SegmentSize()
-		          << ", stats: " << curr.first->stats.statistics->ToString();
+bool ColumnSegmentCatalog::GetPadToByte(double heat) {
+	// padding costs up to 7 bits per value, which is only worth it for segments that are still read
+	return heat >= COLD_SEGMENT_HEAT;
+}
+
+bool ColumnSegmentCatalog::ForegroundTasksWaiting() {
+	// the compaction and prefetch tasks of the catalog itself are not foreground work
+	return TaskScheduler::GetScheduler(db).NumberOfQueuedTasks() > queued_tasks + queued_prefetches;
+}
 
-		/*
-		if (curr.first->stats.statistics) {
-			std::cout << ", stats: " << curr.first->stats.statistics->ToString();
+void ColumnSegmentCatalog::FinishCompactionTask(idx_t start, idx_t end) {
+	{
+		lock_guard<mutex> guard(round_lock);
+		if (start < end) {
+			pending_ranges.emplace_back(start, end);
 		}
-		 */
+		active_tasks--;
+	}
+	round_finished.notify_all();
+}
 
-		std::cout << std::endl;
-		          //<< ", stats: " << curr.first->stats.statistics->ToString()
-		          //<< std::endl;
+void ColumnSegmentCatalog::ApplyDecision(AccessStatisticsSnapshot &entry, bool compact, idx_t hysteresis_rounds) {
+	auto &shard = GetShard(entry.segment);
+	unique_ptr<SegmentPin> pin;
+	{
+		lock_guard<mutex> guard(shard.lock);
+		if (shard.segments.find(entry.segment) == shard.segments.end()) {
+			// the segment was destroyed since the snapshot was taken
+			return;
+		}
 
-		segment_sizes += curr.first->SegmentSize();
-		compressed_size += curr.first->GetDataSize();
-		succinct_size += curr.first->SuccinctSize();
+		auto &statistics = entry.segment->access_statistics;
+		statistics.heat = entry.heat;
+		// Reset statistics to store only access patterns since last compacting iteration. Reads that happened
+		// after the snapshot was taken are kept for the next round.
+		statistics.num_reads.fetch_sub(entry.num_reads, std::memory_order_relaxed);
+		statistics.num_scans.fetch_sub(entry.num_scans, std::memory_order_relaxed);
+
+		if (!entry.compactable || compact == entry.compacted) {
+			statistics.cold_rounds = 0;
+			statistics.hot_rounds = 0;
+			if (!entry.compactable || !compact) {
+				return;
+			}
+		} else {
+			// Hysteresis: only change the representation once the policy asked for it in enough consecutive rounds,
+			// so segments at the edge of the hot set do not flip between the representations every round.
+			idx_t rounds;
+			if (compact) {
+				statistics.hot_rounds = 0;
+				rounds = ++statistics.cold_rounds;
+			} else {
+				statistics.cold_rounds = 0;
+				rounds = ++statistics.hot_rounds;
+			}
+			if (rounds < hysteresis_rounds) {
+				avoided_transitions++;
+				return;
+			}
+			statistics.cold_rounds = 0;
+			statistics.hot_rounds = 0;
+		}
+		// the (un)compaction transcodes the whole segment: registering and destroying the other segments of the
+		// shard must not wait for it
+		pin = make_unique<SegmentPin>(shard, entry.segment);
 	}
+	SegmentTransitionScope transition(entry.segment);
 
-	std::cout << "Segment size: " << segment_sizes << std::endl;
-	std::cout << "Compressed size: " << compressed_size << std::endl;
-	std::cout << "Succinct size: " << succinct_size << std::endl;
+	if (!compact) {
+		entry.segment->Uncompact();
+		return;
+	}
+	// Re-encodes a compacted segment if it moved to another heat tier, e.g. back to FRAME_OF_REFERENCE once it is
+	// read again. This is a no-op if the tier did not change.
+	entry.segment->Compact(GetMaximumEncoding(entry.heat), GetPadToByte(entry.heat));
+	if (entry.compacted && entry.heat < SPILL_SEGMENT_HEAT && SpillEnabled()) {
+		entry.segment->Spill();
+	}
+}
 
-	std::cout << "######" << std::endl;
+size_t ColumnSegmentCatalog::GetTotalDataSize() {
+	size_t data_size = 0;
+	for (auto &shard : shards) {
+		lock_guard<mutex> guard(shard.lock);
+		for (auto segment : shard.segments) {
+			data_size += segment->GetDataSize();
+		}
+	}
+	return data_size;
 }
 
 } // namespace duckdb
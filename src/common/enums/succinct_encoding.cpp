@@ -0,0 +1,25 @@
+#include "duckdb/common/enums/succinct_encoding.hpp"
+#include "duckdb/common/exception.hpp"
+
+namespace duckdb {
+
+// LCOV_EXCL_START
+string SuccinctEncodingToString(SuccinctEncoding encoding) {
+	switch (encoding) {
+	case SuccinctEncoding::FRAME_OF_REFERENCE:
+		return "frame_of_reference";
+	case SuccinctEncoding::PATCHED_FRAME_OF_REFERENCE:
+		return "patched_frame_of_reference";
+	case SuccinctEncoding::DICTIONARY:
+		return "dictionary";
+	case SuccinctEncoding::RUN_LENGTH:
+		return "run_length";
+	case SuccinctEncoding::DELTA:
+		return "delta";
+	default:
+		throw InternalException("Unrecognized succinct encoding!");
+	}
+}
+// LCOV_EXCL_STOP
+
+} // namespace duckdb
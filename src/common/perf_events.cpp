@@ -0,0 +1,93 @@
+#include "duckdb/common/perf_events.hpp"
+
+#if defined(__linux__)
+#include <asm/unistd.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace duckdb {
+
+#if defined(__linux__)
+static int OpenPerfEvent(uint32_t type, uint64_t config, int group_fd) {
+	perf_event_attr attributes;
+	memset(&attributes, 0, sizeof(attributes));
+	attributes.type = type;
+	attributes.size = sizeof(attributes);
+	attributes.config = config;
+	attributes.disabled = group_fd < 0 ? 1 : 0;
+	attributes.exclude_kernel = 1;
+	attributes.exclude_hv = 1;
+	attributes.read_format = PERF_FORMAT_GROUP;
+	// count the calling thread on any CPU
+	return int(syscall(__NR_perf_event_open, &attributes, 0, -1, group_fd, 0));
+}
+#endif
+
+ThreadPerfEvents::ThreadPerfEvents() : leader_fd(-1), opened_events(0) {
+#if defined(__linux__)
+	struct {
+		uint32_t type;
+		uint64_t config;
+	} events[EVENT_COUNT] = {{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+	                         {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+	                         {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+	                         {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}};
+	for (idx_t i = 0; i < EVENT_COUNT; i++) {
+		int fd = OpenPerfEvent(events[i].type, events[i].config, leader_fd);
+		if (fd < 0) {
+			if (leader_fd < 0) {
+				// without cycles there is nothing to measure
+				return;
+			}
+			// e.g. virtual machines often do not expose the cache misses, the other counters still work
+			continue;
+		}
+		if (leader_fd < 0) {
+			leader_fd = fd;
+		}
+		fds[opened_events] = fd;
+		fields[opened_events] = i;
+		opened_events++;
+	}
+	ioctl(leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+ThreadPerfEvents::~ThreadPerfEvents() {
+#if defined(__linux__)
+	for (idx_t i = 0; i < opened_events; i++) {
+		close(fds[i]);
+	}
+#endif
+}
+
+ThreadPerfEvents &ThreadPerfEvents::Get() {
+	static thread_local ThreadPerfEvents events;
+	return events;
+}
+
+PerfEventCounters ThreadPerfEvents::Read() {
+	PerfEventCounters result;
+#if defined(__linux__)
+	if (!IsAvailable()) {
+		return result;
+	}
+	// PERF_FORMAT_GROUP: the number of counters followed by their values
+	uint64_t values[EVENT_COUNT + 1];
+	auto bytes = read(leader_fd, values, sizeof(uint64_t) * (opened_events + 1));
+	if (bytes != ssize_t(sizeof(uint64_t) * (opened_events + 1))) {
+		return result;
+	}
+	idx_t *counters[EVENT_COUNT] = {&result.cycles, &result.instructions, &result.llc_misses, &result.branch_misses};
+	for (idx_t i = 0; i < opened_events && i < values[0]; i++) {
+		*counters[fields[i]] = values[i + 1];
+	}
+#endif
+	return result;
+}
+
+} // namespace duckdb
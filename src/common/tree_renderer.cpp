@@ -494,6 +494,15 @@ unique_ptr<RenderTreeNode> TreeRenderer::CreateNode(const QueryProfiler::TreeNod
 	result->extra_text += "\n" + to_string(op.info.elements);
 	string timing = StringUtil::Format("%.2f", op.info.time);
 	result->extra_text += "\n(" + timing + "s)";
+	auto &perf_events = op.info.perf_events;
+	if (perf_events.cycles > 0) {
+		// only set if perf_events_enabled is set and the thread could open the counters
+		result->extra_text += "\n[INFOSEPARATOR]";
+		result->extra_text += "\ncycles: " + to_string(perf_events.cycles);
+		result->extra_text += "\ninstructions: " + to_string(perf_events.instructions);
+		result->extra_text += "\nllc_misses: " + to_string(perf_events.llc_misses);
+		result->extra_text += "\nbranch_misses: " + to_string(perf_events.branch_misses);
+	}
 	if (config.detailed) {
 		for (auto &info : op.info.executors_info) {
 			if (!info) {
@@ -163,6 +163,10 @@ public:
 };
 
 unique_ptr<GlobalSinkState> PhysicalUngroupedAggregate::GetGlobalSinkState(ClientContext &context) const {
+	if (aggregate_pushdown) {
+		// a prepared plan is executed more than once
+		aggregate_pushdown->Reset();
+	}
 	return make_unique<UngroupedAggregateGlobalState>(*this, context);
 }
 
@@ -564,6 +568,12 @@ void PhysicalUngroupedAggregate::GetData(ExecutionContext &context, DataChunk &c
 		aggregate.function.finalize(state_vector, aggr_input_data, chunk.data[aggr_idx], 1, 0);
 	}
 	VerifyNullHandling(chunk, gstate.state, aggregates);
+	if (aggregate_pushdown) {
+		// add the vectors that the table scan aggregated on the compressed data
+		for (idx_t aggr_idx = 0; aggr_idx < aggregates.size(); aggr_idx++) {
+			chunk.SetValue(aggr_idx, 0, aggregate_pushdown->Finalize(aggr_idx, chunk.GetValue(aggr_idx, 0)));
+		}
+	}
 	state.finished = true;
 }
 
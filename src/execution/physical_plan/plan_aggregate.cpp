@@ -4,12 +4,17 @@
 #include "duckdb/execution/operator/aggregate/physical_perfecthash_aggregate.hpp"
 #include "duckdb/execution/operator/aggregate/physical_ungrouped_aggregate.hpp"
 #include "duckdb/execution/operator/projection/physical_projection.hpp"
+#include "duckdb/execution/operator/scan/physical_table_scan.hpp"
 #include "duckdb/execution/physical_plan_generator.hpp"
+#include "duckdb/function/table/table_scan.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
 #include "duckdb/parser/expression/comparison_expression.hpp"
 #include "duckdb/planner/expression/bound_aggregate_expression.hpp"
+#include "duckdb/planner/expression/bound_reference_expression.hpp"
 #include "duckdb/planner/operator/logical_aggregate.hpp"
 #include "duckdb/storage/statistics/numeric_statistics.hpp"
+#include "duckdb/storage/table/aggregate_pushdown.hpp"
 namespace duckdb {
 
 static uint32_t RequiredBitsForValue(uint32_t n) {
@@ -117,12 +122,85 @@ static bool CanUsePerfectHashAggregate(ClientContext &context, LogicalAggregate
 	return true;
 }
 
+static bool GetPushdownAggregateType(BoundAggregateExpression &aggregate, PushdownAggregateType &type) {
+	auto &name = aggregate.function.name;
+	if (name == "count_star") {
+		type = PushdownAggregateType::COUNT_STAR;
+	} else if (name == "count") {
+		type = PushdownAggregateType::COUNT;
+	} else if (name == "sum" || name == "sum_no_overflow") {
+		type = PushdownAggregateType::SUM;
+	} else if (name == "min") {
+		type = PushdownAggregateType::MIN;
+	} else if (name == "max") {
+		type = PushdownAggregateType::MAX;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+//! Ungrouped SUM, MIN, MAX and COUNT aggregates of the integer columns of an unfiltered table scan can be computed by
+//! the scan on the compressed data of the segments, see AggregatePushdown
+static shared_ptr<AggregatePushdown> CreateAggregatePushdown(ClientContext &context, PhysicalOperator &plan,
+                                                             vector<unique_ptr<Expression>> &aggregates) {
+	if (!DBConfig::GetConfig(context).aggregate_pushdown_enabled || aggregates.empty() ||
+	    plan.type != PhysicalOperatorType::TABLE_SCAN) {
+		return nullptr;
+	}
+	auto &scan = (PhysicalTableScan &)plan;
+	if (scan.function.name != "seq_scan" || !scan.bind_data || scan.table_filters) {
+		return nullptr;
+	}
+	auto &bind_data = (TableScanBindData &)*scan.bind_data;
+	if (bind_data.is_index_scan || bind_data.is_create_index) {
+		return nullptr;
+	}
+	vector<PushdownAggregate> pushdown_aggregates;
+	for (auto &expression : aggregates) {
+		auto &aggregate = (BoundAggregateExpression &)*expression;
+		PushdownAggregateType type;
+		if (aggregate.IsDistinct() || aggregate.filter || !GetPushdownAggregateType(aggregate, type)) {
+			return nullptr;
+		}
+		if (type == PushdownAggregateType::COUNT_STAR) {
+			pushdown_aggregates.emplace_back(type, DConstants::INVALID_INDEX);
+			continue;
+		}
+		if (aggregate.children.size() != 1 || !aggregate.return_type.IsIntegral() ||
+		    aggregate.children[0]->type != ExpressionType::BOUND_REF) {
+			return nullptr;
+		}
+		auto &input_type = aggregate.children[0]->return_type;
+		if (!input_type.IsIntegral() || input_type.id() == LogicalTypeId::HUGEINT) {
+			// the compressed values are aggregated as 64-bit integers
+			return nullptr;
+		}
+		// map the output column of the scan to its column id
+		auto column_index = ((BoundReferenceExpression &)*aggregate.children[0]).index;
+		if (!scan.projection_ids.empty()) {
+			column_index = scan.projection_ids[column_index];
+		}
+		if (scan.column_ids[column_index] == COLUMN_IDENTIFIER_ROW_ID) {
+			return nullptr;
+		}
+		pushdown_aggregates.emplace_back(type, column_index);
+	}
+	return make_shared<AggregatePushdown>(move(pushdown_aggregates), scan.column_ids.size());
+}
+
 unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalAggregate &op) {
 	unique_ptr<PhysicalOperator> groupby;
 	D_ASSERT(op.children.size() == 1);
 
 	auto plan = CreatePlan(*op.children[0]);
 
+	shared_ptr<AggregatePushdown> aggregate_pushdown;
+	if (op.groups.empty()) {
+		// the aggregates refer to the columns of the scan until their inputs are extracted into a projection
+		aggregate_pushdown = CreateAggregatePushdown(context, *plan, op.expressions);
+	}
+	auto child_plan = plan.get();
 	plan = ExtractAggregateExpressions(move(plan), op.expressions, op.groups);
 
 	if (op.groups.empty()) {
@@ -138,8 +216,14 @@ unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalAggregate
 			}
 		}
 		if (use_simple_aggregation) {
-			groupby = make_unique_base<PhysicalOperator, PhysicalUngroupedAggregate>(op.types, move(op.expressions),
-			                                                                         op.estimated_cardinality);
+			auto ungrouped_aggregate =
+			    make_unique<PhysicalUngroupedAggregate>(op.types, move(op.expressions), op.estimated_cardinality);
+			if (aggregate_pushdown) {
+				auto &scan = (PhysicalTableScan &)*child_plan;
+				((TableScanBindData &)*scan.bind_data).aggregate_pushdown = aggregate_pushdown;
+				ungrouped_aggregate->aggregate_pushdown = move(aggregate_pushdown);
+			}
+			groupby = move(ungrouped_aggregate);
 		} else {
 			groupby = make_unique_base<PhysicalOperator, PhysicalHashAggregate>(context, op.types, move(op.expressions),
 			                                                                    op.estimated_cardinality);
@@ -0,0 +1,115 @@
+#include "duckdb/function/table/system_functions.hpp"
+#include "duckdb/catalog/catalog_entry/column_segment_catalog.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+
+namespace duckdb {
+
+struct DuckDBCompactionStatisticValue {
+	string name;
+	int64_t value;
+	string description;
+};
+
+struct DuckDBCompactionStatisticsData : public GlobalTableFunctionState {
+	DuckDBCompactionStatisticsData() : offset(0) {
+	}
+
+	vector<DuckDBCompactionStatisticValue> statistics;
+	idx_t offset;
+};
+
+static unique_ptr<FunctionData> DuckDBCompactionStatisticsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                               vector<LogicalType> &return_types,
+                                                               vector<string> &names) {
+	names.emplace_back("name");
+	return_types.emplace_back(LogicalType::VARCHAR);
+
+	names.emplace_back("value");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("description");
+	return_types.emplace_back(LogicalType::VARCHAR);
+
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> DuckDBCompactionStatisticsInit(ClientContext &context,
+                                                                    TableFunctionInitInput &input) {
+	auto result = make_unique<DuckDBCompactionStatisticsData>();
+	auto &catalog = DatabaseInstance::GetDatabase(context).GetColumnSegmentCatalog();
+
+	idx_t compacted_segments = 0;
+	idx_t spilled_segments = 0;
+	idx_t data_size = 0;
+	idx_t segment_size = 0;
+	auto segments = catalog.GetSegmentInfo();
+	for (auto &segment : segments) {
+		compacted_segments += segment.compacted;
+		spilled_segments += segment.spilled;
+		data_size += segment.data_size;
+		segment_size += segment.segment_size;
+	}
+
+	auto add = [&](string name, int64_t value, string description) {
+		result->statistics.push_back({move(name), value, move(description)});
+	};
+	add("segments", segments.size(), "Number of in-memory data segments");
+	add("compacted_segments", compacted_segments, "Number of segments that are currently compacted");
+	add("spilled_segments", spilled_segments, "Number of compacted segments that are currently in the spill file");
+	add("data_size", data_size, "Memory used by the data of the segments, in bytes");
+	add("segment_size", segment_size, "Memory the data of the segments would use uncompacted, in bytes");
+	add("bytes_saved", int64_t(segment_size) - int64_t(data_size), "Memory saved by the compacted segments, in bytes");
+	add("compactions", catalog.GetCompactionCount(), "Number of times a segment was compacted or re-encoded");
+	add("uncompactions", catalog.GetUncompactionCount(), "Number of times a segment was uncompacted");
+	add("avoided_transitions", catalog.GetAvoidedTransitionCount(),
+	    "Number of representation changes held back by adaptive_compaction_hysteresis_rounds");
+	add("compaction_time_us", catalog.GetCompactionTime() / 1000, "Time spent compacting segments, in microseconds");
+	add("uncompaction_time_us", catalog.GetUncompactionTime() / 1000,
+	    "Time spent uncompacting segments, in microseconds");
+	add("rounds", catalog.GetRoundCount(), "Number of rounds the background compaction finished");
+	add("reclaimed_segments", catalog.GetReclaimedSegmentCount(),
+	    "Number of segments compacted to free memory when the memory limit was reached");
+	add("reclaimed_bytes", catalog.GetReclaimedMemory(),
+	    "Memory freed by compacting segments when the memory limit was reached, in bytes");
+	add("delta_appends", catalog.GetDeltaAppendCount(),
+	    "Number of appends to compacted segments buffered in their delta instead of uncompacting them");
+	add("delta_merges", catalog.GetDeltaMergeCount(),
+	    "Number of times the appended rows of a compacted segment were packed");
+	add("spills", catalog.GetSpillCount(), "Number of times a compacted segment was moved to the spill file");
+	add("spilled_bytes", catalog.GetSpilledMemory(), "Memory freed by moving segments to the spill file, in bytes");
+	add("spill_loads", catalog.GetSpillLoadCount(), "Number of times a spilled segment was loaded, by a read or a prefetch");
+	add("spill_prefetches", catalog.GetPrefetchCount(), "Number of spilled segments loaded ahead of a scan");
+	add("spill_file_size", catalog.GetSpillFileSize(), "Size of the spill file, in bytes");
+	return move(result);
+}
+
+void DuckDBCompactionStatisticsFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = (DuckDBCompactionStatisticsData &)*data_p.global_state;
+	if (data.offset >= data.statistics.size()) {
+		// finished returning values
+		return;
+	}
+	// start returning values
+	// either fill up the chunk or return all the remaining columns
+	idx_t count = 0;
+	while (data.offset < data.statistics.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &entry = data.statistics[data.offset++];
+
+		// name, LogicalType::VARCHAR
+		output.SetValue(0, count, Value(entry.name));
+		// value, LogicalType::BIGINT
+		output.SetValue(1, count, Value::BIGINT(entry.value));
+		// description, LogicalType::VARCHAR
+		output.SetValue(2, count, Value(entry.description));
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+void DuckDBCompactionStatisticsFun::RegisterFunction(BuiltinFunctions &set) {
+	set.AddFunction(TableFunction("duckdb_compaction_statistics", {}, DuckDBCompactionStatisticsFunction,
+	                              DuckDBCompactionStatisticsBind, DuckDBCompactionStatisticsInit));
+}
+
+} // namespace duckdb
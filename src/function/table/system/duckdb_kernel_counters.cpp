@@ -0,0 +1,96 @@
+#include "duckdb/function/table/system_functions.hpp"
+#include "duckdb/catalog/catalog_entry/column_segment_catalog.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+
+namespace duckdb {
+
+struct DuckDBKernelCountersData : public GlobalTableFunctionState {
+	DuckDBKernelCountersData() : offset(0) {
+	}
+
+	vector<SegmentKernelInfo> entries;
+	idx_t offset;
+};
+
+static unique_ptr<FunctionData> DuckDBKernelCountersBind(ClientContext &context, TableFunctionBindInput &input,
+                                                         vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("kernel");
+	return_types.emplace_back(LogicalType::VARCHAR);
+
+	names.emplace_back("bit_width");
+	return_types.emplace_back(LogicalType::UTINYINT);
+
+	names.emplace_back("calls");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("tuple_count");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("cycles");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("instructions");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("llc_misses");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("branch_misses");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("cycles_per_tuple");
+	return_types.emplace_back(LogicalType::DOUBLE);
+
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> DuckDBKernelCountersInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto result = make_unique<DuckDBKernelCountersData>();
+	result->entries = DatabaseInstance::GetDatabase(context).GetColumnSegmentCatalog().GetKernelCounters();
+	return move(result);
+}
+
+void DuckDBKernelCountersFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = (DuckDBKernelCountersData &)*data_p.global_state;
+	if (data.offset >= data.entries.size()) {
+		// finished returning values
+		return;
+	}
+	// start returning values
+	// either fill up the chunk or return all the remaining columns
+	idx_t count = 0;
+	while (data.offset < data.entries.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &entry = data.entries[data.offset++];
+
+		// kernel, LogicalType::VARCHAR
+		output.SetValue(0, count, Value(SegmentKernelToString(entry.kernel)));
+		// bit_width, LogicalType::UTINYINT (NULL if the values are not stored in a succinct vector)
+		output.SetValue(1, count, entry.width == 0 ? Value(LogicalType::UTINYINT) : Value::UTINYINT(entry.width));
+		// calls, LogicalType::BIGINT
+		output.SetValue(2, count, Value::BIGINT(entry.calls));
+		// tuple_count, LogicalType::BIGINT
+		output.SetValue(3, count, Value::BIGINT(entry.values));
+		// cycles, LogicalType::BIGINT
+		output.SetValue(4, count, Value::BIGINT(entry.counters.cycles));
+		// instructions, LogicalType::BIGINT
+		output.SetValue(5, count, Value::BIGINT(entry.counters.instructions));
+		// llc_misses, LogicalType::BIGINT
+		output.SetValue(6, count, Value::BIGINT(entry.counters.llc_misses));
+		// branch_misses, LogicalType::BIGINT
+		output.SetValue(7, count, Value::BIGINT(entry.counters.branch_misses));
+		// cycles_per_tuple, LogicalType::DOUBLE
+		output.SetValue(8, count,
+		                entry.values == 0 ? Value(LogicalType::DOUBLE)
+		                                  : Value::DOUBLE(double(entry.counters.cycles) / double(entry.values)));
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+void DuckDBKernelCountersFun::RegisterFunction(BuiltinFunctions &set) {
+	set.AddFunction(TableFunction("duckdb_kernel_counters", {}, DuckDBKernelCountersFunction, DuckDBKernelCountersBind,
+	                              DuckDBKernelCountersInit));
+}
+
+} // namespace duckdb
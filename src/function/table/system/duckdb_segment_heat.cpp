@@ -0,0 +1,141 @@
+#include "duckdb/function/table/system_functions.hpp"
+#include "duckdb/catalog/catalog_entry/column_segment_catalog.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+struct DuckDBSegmentHeatData : public GlobalTableFunctionState {
+	DuckDBSegmentHeatData() : offset(0) {
+	}
+
+	vector<ColumnSegmentInfo> segments;
+	idx_t offset;
+};
+
+static unique_ptr<FunctionData> DuckDBSegmentHeatBind(ClientContext &context, TableFunctionBindInput &input,
+                                                      vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("segment_id");
+	return_types.emplace_back(LogicalType::UBIGINT);
+
+	names.emplace_back("segment_type");
+	return_types.emplace_back(LogicalType::VARCHAR);
+
+	names.emplace_back("row_start");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("count");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("compactable");
+	return_types.emplace_back(LogicalType::BOOLEAN);
+
+	names.emplace_back("compacted");
+	return_types.emplace_back(LogicalType::BOOLEAN);
+
+	names.emplace_back("spilled");
+	return_types.emplace_back(LogicalType::BOOLEAN);
+
+	names.emplace_back("encoding");
+	return_types.emplace_back(LogicalType::VARCHAR);
+
+	names.emplace_back("bit_width");
+	return_types.emplace_back(LogicalType::INTEGER);
+
+	names.emplace_back("frame_of_reference");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("data_size");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("segment_size");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("num_reads");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("num_scans");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("heat");
+	return_types.emplace_back(LogicalType::DOUBLE);
+
+	names.emplace_back("last_transition");
+	return_types.emplace_back(LogicalType::TIMESTAMP);
+
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> DuckDBSegmentHeatInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto result = make_unique<DuckDBSegmentHeatData>();
+	result->segments = DatabaseInstance::GetDatabase(context).GetColumnSegmentCatalog().GetSegmentInfo();
+	// report the segments in a stable order
+	std::sort(result->segments.begin(), result->segments.end(),
+	          [](const ColumnSegmentInfo &left, const ColumnSegmentInfo &right) {
+		          if (left.row_start != right.row_start) {
+			          return left.row_start < right.row_start;
+		          }
+		          return left.segment_id < right.segment_id;
+	          });
+	return move(result);
+}
+
+void DuckDBSegmentHeatFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = (DuckDBSegmentHeatData &)*data_p.global_state;
+	if (data.offset >= data.segments.size()) {
+		// finished returning values
+		return;
+	}
+	// start returning values
+	// either fill up the chunk or return all the remaining columns
+	idx_t count = 0;
+	while (data.offset < data.segments.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &entry = data.segments[data.offset++];
+
+		// segment_id, LogicalType::UBIGINT
+		output.SetValue(0, count, Value::UBIGINT(entry.segment_id));
+		// segment_type, LogicalType::VARCHAR
+		output.SetValue(1, count, Value(entry.type.ToString()));
+		// row_start, LogicalType::BIGINT
+		output.SetValue(2, count, Value::BIGINT(entry.row_start));
+		// count, LogicalType::BIGINT
+		output.SetValue(3, count, Value::BIGINT(entry.count));
+		// compactable, LogicalType::BOOLEAN
+		output.SetValue(4, count, Value::BOOLEAN(entry.compactable));
+		// compacted, LogicalType::BOOLEAN
+		output.SetValue(5, count, Value::BOOLEAN(entry.compacted));
+		// spilled, LogicalType::BOOLEAN
+		output.SetValue(6, count, Value::BOOLEAN(entry.spilled));
+		// encoding, LogicalType::VARCHAR
+		output.SetValue(7, count,
+		                entry.compacted ? Value(SuccinctEncodingToString(entry.encoding)) : Value("uncompressed"));
+		// bit_width, LogicalType::INTEGER
+		output.SetValue(8, count, entry.width == 0 ? Value() : Value::INTEGER(entry.width));
+		// frame_of_reference, LogicalType::BIGINT
+		output.SetValue(9, count, entry.compacted ? Value::BIGINT(int64_t(entry.frame_of_reference)) : Value());
+		// data_size, LogicalType::BIGINT
+		output.SetValue(10, count, Value::BIGINT(entry.data_size));
+		// segment_size, LogicalType::BIGINT
+		output.SetValue(11, count, Value::BIGINT(entry.segment_size));
+		// num_reads, LogicalType::BIGINT
+		output.SetValue(12, count, Value::BIGINT(entry.num_reads));
+		// num_scans, LogicalType::BIGINT
+		output.SetValue(13, count, Value::BIGINT(entry.num_scans));
+		// heat, LogicalType::DOUBLE
+		output.SetValue(14, count, Value::DOUBLE(entry.heat));
+		// last_transition, LogicalType::TIMESTAMP
+		output.SetValue(15, count,
+		                entry.compactable ? Value::TIMESTAMP(entry.last_transition) : Value(LogicalType::TIMESTAMP));
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+void DuckDBSegmentHeatFun::RegisterFunction(BuiltinFunctions &set) {
+	set.AddFunction(TableFunction("duckdb_segment_heat", {}, DuckDBSegmentHeatFunction, DuckDBSegmentHeatBind,
+	                              DuckDBSegmentHeatInit));
+}
+
+} // namespace duckdb
@@ -19,11 +19,14 @@ void BuiltinFunctions::RegisterSQLiteFunctions() {
 	PragmaDetailedProfilingOutput::RegisterFunction(*this);
 
 	DuckDBColumnsFun::RegisterFunction(*this);
+	DuckDBCompactionStatisticsFun::RegisterFunction(*this);
 	DuckDBConstraintsFun::RegisterFunction(*this);
 	DuckDBFunctionsFun::RegisterFunction(*this);
+	DuckDBKernelCountersFun::RegisterFunction(*this);
 	DuckDBKeywordsFun::RegisterFunction(*this);
 	DuckDBIndexesFun::RegisterFunction(*this);
 	DuckDBSchemasFun::RegisterFunction(*this);
+	DuckDBSegmentHeatFun::RegisterFunction(*this);
 	DuckDBDependenciesFun::RegisterFunction(*this);
 	DuckDBExtensionsFun::RegisterFunction(*this);
 	DuckDBSequencesFun::RegisterFunction(*this);
@@ -10,6 +10,7 @@
 #include "duckdb/planner/expression_iterator.hpp"
 #include "duckdb/planner/operator/logical_get.hpp"
 #include "duckdb/storage/data_table.hpp"
+#include "duckdb/storage/table/aggregate_pushdown.hpp"
 #include "duckdb/transaction/local_storage.hpp"
 #include "duckdb/transaction/transaction.hpp"
 #include "duckdb/main/attached_database.hpp"
@@ -72,7 +73,7 @@ static unique_ptr<LocalTableFunctionState> TableScanInitLocal(ExecutionContext &
 		auto storage_idx = GetStorageIndex(*bind_data.table, col);
 		col = storage_idx;
 	}
-	result->scan_state.Initialize(move(column_ids), input.filters);
+	result->scan_state.Initialize(move(column_ids), input.filters, bind_data.aggregate_pushdown.get());
 	TableScanParallelStateNext(context.client, input.bind_data, result.get(), gstate);
 	if (input.CanRemoveFilterColumns()) {
 		auto &tsgs = (TableScanGlobalState &)*gstate;
@@ -133,6 +134,10 @@ static void TableScanFunc(ClientContext &context, TableFunctionInput &data_p, Da
 			return;
 		}
 		if (!TableScanParallelStateNext(context, data_p.bind_data, data_p.local_state, data_p.global_state)) {
+			if (bind_data.aggregate_pushdown) {
+				// hand the aggregates computed by this scan to the aggregate operator
+				state.scan_state.GetAggregatePushdown()->Flush();
+			}
 			return;
 		}
 	} while (true);
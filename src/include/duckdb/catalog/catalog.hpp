@@ -79,8 +79,8 @@ public:
 	//! Get the specific Catalog from the AttachedDatabase
 	DUCKDB_API static Catalog &GetCatalog(AttachedDatabase &db);
 
-	//! Get the Column Segment Catalog from the AttachedDatabase
-	static ColumnSegmentCatalog* GetColumnSegmentCatalog();
+	//! Get the Column Segment Catalog of the database instance
+	ColumnSegmentCatalog* GetColumnSegmentCatalog();
 
 	DUCKDB_API DependencyManager &GetDependencyManager() {
 		return *dependency_manager;
@@ -235,8 +235,6 @@ public:
 private:
 	//! Reference to the database
 	AttachedDatabase &db;
-	//! Catalog with statistics for individual column segments
-	static ColumnSegmentCatalog* column_segment_catalog;
 
 private:
 	CatalogEntryLookup LookupEntryInternal(CatalogTransaction transaction, CatalogType type, const string &schema,
@@ -1,50 +1,454 @@
 #pragma once
 
-#include "duckdb.h"
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/enums/adaptive_compaction_policy.hpp"
+#include "duckdb/common/enums/succinct_encoding.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/pair.hpp"
+#include "duckdb/common/perf_events.hpp"
+#include "duckdb/common/thread.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/unordered_set.hpp"
 
+#include <condition_variable>
 #include <iostream>
-#include <atomic>
-#include <unordered_map>
 
 namespace duckdb {
 class ColumnSegment;
 class ColumnSegmentCatalog;
+class DatabaseInstance;
+class ProducerToken;
+class SegmentCompactionTask;
+class SegmentPrefetchTask;
+class SegmentSpillFile;
+struct DBConfig;
 
+//! Access counters of a single column segment. They are owned by the segment itself and updated by the scanner
+//! threads with relaxed atomics, so tracking a read never takes a lock.
+//! Reads are split in two kinds: a vector that a filter found qualifying tuples in, or a fetched row, is a read of the
+//! data the workload actually uses. Every vector a scan reads (with or without filter) is a scan touch, which only
+//! counts with adaptive_compaction_scan_weight towards the heat, so that a full table scan does not make every segment
+//! look hot.
 struct AccessStatistics {
+	AccessStatistics() : num_reads(0), num_scans(0), heat(0), cold_rounds(0), hot_rounds(0) {
+	}
+
+	//! Qualifying reads (filtered vectors with matching rows, fetched rows) since the last compaction round
+	atomic<idx_t> num_reads;
+	//! Vectors read by scans since the last compaction round
+	atomic<idx_t> num_scans;
+
+	//! The fields below are only used by the background compaction thread (while holding the shard lock).
+	//! Exponentially decayed number of reads per compaction round
+	double heat;
+	//! Consecutive rounds the policy wanted to compact the (uncompacted) segment
+	idx_t cold_rounds;
+	//! Consecutive rounds the policy wanted to uncompact the (compacted) segment
+	idx_t hot_rounds;
+};
+
+//! Point-in-time copy of the access statistics of a segment, used by the background compaction thread.
+struct AccessStatisticsSnapshot {
+	ColumnSegment *segment;
+	idx_t num_reads;
+	idx_t num_scans;
+	//! Decayed read count, including the reads of this round.
+	double heat;
+	//! Whether the segment can be compacted at all.
+	bool compactable;
+	//! Whether the segment is currently compacted.
+	bool compacted;
+	//! Number of values stored in the segment.
+	idx_t count;
+	//! Bit width of the (possibly future) compacted representation.
+	uint8_t width;
+	//! Size of the segment when it is not compacted.
+	idx_t uncompacted_size;
+	//! Size of the segment when it is compacted.
+	idx_t compacted_size;
+
+	inline bool operator<(const AccessStatisticsSnapshot &other) const {
+		return heat < other.heat;
+	}
+};
+
+//! The current state of a registered segment, as reported by duckdb_segment_heat().
+struct ColumnSegmentInfo {
+	//! Identifies the segment for as long as it lives
+	idx_t segment_id;
+	LogicalType type;
+	idx_t row_start;
+	idx_t count;
+	bool compactable;
+	bool compacted;
+	SuccinctEncoding encoding;
+	//! Bit width of the succinct vector, 0 if the segment is not stored in one
+	uint8_t width;
+	uint64_t frame_of_reference;
+	idx_t data_size;
+	idx_t segment_size;
 	idx_t num_reads;
+	idx_t num_scans;
+	double heat;
+	//! When the segment switched to its current representation
+	timestamp_t last_transition;
+	//! Whether the vectors of the segment were moved to the spill file
+	bool spilled;
+};
+
+//! The operations on segments whose hardware counters are collected when perf_events_enabled is set
+enum class SegmentKernel : uint8_t {
+	SCAN = 0,
+	FILTER = 1,
+	FETCH = 2,
+	COMPACTION = 3,
+	UNCOMPACTION = 4,
+	AGGREGATE = 5
+};
+
+string SegmentKernelToString(SegmentKernel kernel);
+
+//! The hardware counters of an operation on the segments of one bit width, summed over all segments and threads
+struct SegmentKernelCounters {
+	SegmentKernelCounters() : calls(0), values(0), cycles(0), instructions(0), llc_misses(0), branch_misses(0) {
+	}
+
+	atomic<idx_t> calls;
+	atomic<idx_t> values;
+	atomic<idx_t> cycles;
+	atomic<idx_t> instructions;
+	atomic<idx_t> llc_misses;
+	atomic<idx_t> branch_misses;
+};
 
-	inline bool operator<(AccessStatistics x) {
-      	return num_reads < x.num_reads;
-    }
+//! The counters of an operation at one bit width, as reported by duckdb_kernel_counters().
+struct SegmentKernelInfo {
+	SegmentKernel kernel;
+	//! The bit width of the succinct vector, 0 for segments that are not stored in one
+	uint8_t width;
+	idx_t calls;
+	idx_t values;
+	PerfEventCounters counters;
 };
 
+//! Marks the current thread as changing the representation of a segment while it lives. The thread holds the lock of
+//! that segment (and possibly a lock of the segment registry), so the buffer manager must not reclaim memory from that
+//! segment (or, while a registry lock is held, from any segment) for the allocations of the thread.
+class SegmentTransitionScope {
+public:
+	explicit SegmentTransitionScope(ColumnSegment *segment, bool holds_registry_lock = false);
+	~SegmentTransitionScope();
+
+	//! The segment the current thread changes, if any
+	static ColumnSegment *CurrentSegment();
+	//! Whether the current thread holds a lock of the segment registry
+	static bool HoldsRegistryLock();
+
+private:
+	ColumnSegment *previous_segment;
+	bool previous_holds_registry_lock;
+};
+
+//! One shard of the segment registry. Segments are spread over the shards by address, so registering and
+//! unregistering segments from different threads rarely contends on the same lock.
+struct ColumnSegmentCatalogShard {
+	mutex lock;
+	unordered_set<ColumnSegment *> segments;
+	//! Signaled when a segment of the shard is unpinned, see ColumnSegment::catalog_pins
+	std::condition_variable unpinned;
+};
+
+//! Tracks the segments of a database instance and adapts their representation to the access pattern. A background
+//! thread takes a snapshot of the access statistics every round and lets tasks on the TaskScheduler (un)compact the
+//! chosen segments.
 class ColumnSegmentCatalog {
+	friend class SegmentCompactionTask;
+	friend class SegmentPrefetchTask;
+
 public:
-	ColumnSegmentCatalog();
+	static constexpr const idx_t NUM_SHARDS = 64;
+	//! Number of segments a single compaction task works on
+	static constexpr const idx_t SEGMENTS_PER_TASK = 64;
+	static constexpr const idx_t KERNEL_COUNT = 6;
+	//! Segments with a lower heat are read so rarely that they may use the encodings that are expensive to decode and
+	//! the tight bit widths. Warmer compacted segments use byte aligned widths, which decode almost as fast as
+	//! uncompressed data. The cost model policy compacts them whether or not the memory target is exceeded.
+	static constexpr const double COLD_SEGMENT_HEAT = 0.5;
+	//! Compacted segments with a lower heat have not been read for many rounds. With adaptive_compaction_spill_enabled
+	//! their vectors are moved to the spill file.
+	static constexpr const double SPILL_SEGMENT_HEAT = 0.005;
+
+public:
+	explicit ColumnSegmentCatalog(DatabaseInstance &db);
+	~ColumnSegmentCatalog();
 
 	void AddColumnSegment(ColumnSegment* segment);
+	//! Count a qualifying read of the segment: a fetched row or a scanned vector in which a filter found matching rows
 	void AddReadAccess(ColumnSegment* segment);
+	//! Count a vector of the segment read by a scan
+	void AddScanAccess(ColumnSegment* segment);
 	void RemoveColumnSegment(ColumnSegment* segment);
 
-	void Print();
-
-	[[noreturn]] void CompressLowestKSegments();
+	//! The loop of the background thread, runs until Shutdown() is called
+	void CompressLowestKSegments();
 
+	//! Start the background thread, once. Called by Configure when adaptive compaction is turned on.
 	void EnableBackgroundThreadCompaction();
+	//! Stop the background thread, waiting for the running compaction tasks to finish
+	void Shutdown();
 
 	inline bool BackgroundCompactionEnabled() {
 		return background_compaction_enabled;
 	}
 
+	//! Whether the background thread adapts the representation of the segments (adaptive_succinct_compression_enabled).
+	//! Otherwise the segments compact themselves once they are full or scanned.
+	inline bool AdaptiveCompactionEnabled() {
+		return adaptive_compaction_enabled;
+	}
+
 	void CompactAllSegments();
 
 	size_t GetTotalDataSize();
 
+	//! Take a snapshot of the access statistics of all registered segments. Only the registry shards are locked
+	//! (one at a time), scans are never blocked. Segments that are appended to or compacted at the time are left out,
+	//! their statistics are read under their lock. 'used_memory' is set to the memory used by the buffer manager.
+	vector<AccessStatisticsSnapshot> SnapshotStatistics(idx_t &used_memory);
+
+	//! The state of every registered segment. Like SnapshotStatistics, this only locks the registry shards.
+	vector<ColumnSegmentInfo> GetSegmentInfo();
+
+	//! Apply the adaptive compaction options of the config. Takes effect at the next compaction round.
+	void Configure(DBConfig &config);
+
+	//! Compact the coldest uncompacted segments (and drop their uncompressed blocks) until 'required_memory' bytes are
+	//! freed or no segment is left. Called by the buffer manager before it evicts blocks. Only one thread reclaims at a
+	//! time and it skips the segments (and registry shards) that are locked, so it never waits for another thread.
+	//! Returns the number of bytes freed.
+	idx_t ReclaimMemory(idx_t required_memory);
+	//! Called by a segment whose state changed: 'reclaimable' segments free memory when they are compacted (they are
+	//! uncompacted, or hold a delta buffer or an uncompressed block), 'spillable' ones can be moved to the spill file.
+	//! ReclaimMemory returns at once if there are none.
+	void UpdateReclaimableSegments(bool was_reclaimable, bool reclaimable, bool was_spillable, bool spillable) {
+		if (reclaimable != was_reclaimable) {
+			reclaimable ? reclaimable_segments++ : reclaimable_segments--;
+		}
+		if (spillable != was_spillable) {
+			spillable ? spillable_segments++ : spillable_segments--;
+		}
+	}
+
+	//! Whether cold compacted segments are moved to the spill file (adaptive_compaction_spill_enabled)
+	inline bool SpillEnabled() {
+		return spill_enabled.load(std::memory_order_relaxed);
+	}
+	//! The spill file, created in the temporary directory on the first use. nullptr if there is no temporary
+	//! directory.
+	shared_ptr<SegmentSpillFile> GetSpillFile();
+	//! Load a spilled segment on a thread of the TaskScheduler, e.g. the segment a scan reaches next. Does nothing
+	//! if there is no other thread that could load it before the scan gets there.
+	void PrefetchSegment(ColumnSegment *segment);
+
+	//! Whether the segments measure the hardware counters of their operations (perf_events_enabled)
+	inline bool PerfEventsEnabled() {
+		return perf_events_enabled.load(std::memory_order_relaxed);
+	}
+	//! Add the counters of an operation on 'values' values of a segment, 'width' is the bit width of its succinct
+	//! vector (0 if it is not stored in one)
+	void RecordKernel(SegmentKernel kernel, uint8_t width, idx_t values, const PerfEventCounters &counters);
+	//! The counters of every operation and bit width that was measured
+	vector<SegmentKernelInfo> GetKernelCounters();
+
+	//! Called by a segment after it was compacted (or re-encoded), which took 'time_ns' nanoseconds
+	void RecordCompaction(idx_t time_ns) {
+		compactions++;
+		compaction_time_ns += time_ns;
+	}
+	//! Called by a segment after it was uncompacted, which took 'time_ns' nanoseconds
+	void RecordUncompaction(idx_t time_ns) {
+		uncompactions++;
+		uncompaction_time_ns += time_ns;
+	}
+
+	//! Called by a segment after an append was buffered in its delta instead of uncompacting it
+	void RecordDeltaAppend() {
+		delta_appends++;
+	}
+	//! Called by a segment after the rows of its delta buffer were packed
+	void RecordDeltaMerge() {
+		delta_merges++;
+	}
+
+	//! Called by a segment after its vectors were moved to the spill file, which freed 'memory' bytes
+	void RecordSpill(idx_t memory) {
+		spills++;
+		spilled_memory += memory;
+	}
+	//! Called by a segment after its vectors were loaded from the spill file
+	void RecordSpillLoad() {
+		spill_loads++;
+	}
+
+	//! Number of times a segment was compacted or re-encoded, by the background thread, a scan or an append
+	idx_t GetCompactionCount() {
+		return compactions;
+	}
+	//! Number of times a segment was uncompacted, by the background thread or an append
+	idx_t GetUncompactionCount() {
+		return uncompactions;
+	}
+	//! Number of representation changes the policy asked for but that were held back by the hysteresis
+	idx_t GetAvoidedTransitionCount() {
+		return avoided_transitions;
+	}
+	//! Time spent compacting segments, in nanoseconds
+	idx_t GetCompactionTime() {
+		return compaction_time_ns;
+	}
+	//! Time spent uncompacting segments, in nanoseconds
+	idx_t GetUncompactionTime() {
+		return uncompaction_time_ns;
+	}
+	//! Number of compaction rounds the background thread finished
+	idx_t GetRoundCount() {
+		return rounds;
+	}
+	//! Number of segments compacted because the buffer manager ran out of memory
+	idx_t GetReclaimedSegmentCount() {
+		return reclaimed_segments;
+	}
+	//! Memory freed by compacting segments for the buffer manager, in bytes
+	idx_t GetReclaimedMemory() {
+		return reclaimed_memory;
+	}
+	//! Number of appends to compacted segments that went to their delta buffer
+	idx_t GetDeltaAppendCount() {
+		return delta_appends;
+	}
+	//! Number of times the delta buffer of a segment was folded into its packed vectors
+	idx_t GetDeltaMergeCount() {
+		return delta_merges;
+	}
+	//! Number of times the vectors of a segment were moved to the spill file
+	idx_t GetSpillCount() {
+		return spills;
+	}
+	//! Memory freed by moving segments to the spill file, in bytes
+	idx_t GetSpilledMemory() {
+		return spilled_memory;
+	}
+	//! Number of times a spilled segment was loaded again, by a read or a prefetch
+	idx_t GetSpillLoadCount() {
+		return spill_loads;
+	}
+	//! Number of spilled segments loaded ahead of a scan
+	idx_t GetPrefetchCount() {
+		return prefetches;
+	}
+	//! The size of the spill file, in bytes
+	idx_t GetSpillFileSize();
+
 private:
-	std::unordered_map<ColumnSegment*, AccessStatistics> statistics;
-	idx_t event_counter;
-	bool background_thread_started;
-	bool background_compaction_enabled;
+	ColumnSegmentCatalogShard &GetShard(ColumnSegment *segment);
+
+	//! Decide for every segment of the snapshot if it should be compacted (true) or uncompacted (false).
+	vector<bool> ChooseSegmentsFixedRatio(vector<AccessStatisticsSnapshot> &segments, double compaction_ratio);
+	vector<bool> ChooseSegmentsCostModel(vector<AccessStatisticsSnapshot> &segments, idx_t used_memory,
+	                                     idx_t target_memory, double decode_budget_ns);
+
+	//! Measure the per-value cost of decoding every bit width on this machine.
+	void CalibrateDecodeCosts();
+
+	//! Apply the decisions of a round to the segments, using at most 'thread_budget' threads at a time.
+	void RunCompactionRound(vector<AccessStatisticsSnapshot> &segments, const vector<bool> &compact,
+	                        idx_t hysteresis_rounds, idx_t thread_budget);
+	//! Update the statistics of a segment and (un)compact it if the policy asked for it in enough rounds. The segment
+	//! is pinned while it changes its representation, the lock of its registry shard is only held to update the
+	//! statistics.
+	void ApplyDecision(AccessStatisticsSnapshot &entry, bool compact, idx_t hysteresis_rounds);
+	//! The most expensive encoding a compacted segment with the given heat may use
+	static SuccinctEncoding GetMaximumEncoding(double heat);
+	//! Whether a compacted segment with the given heat rounds its widths up to whole bytes
+	static bool GetPadToByte(double heat);
+	//! Whether tasks of queries are waiting for a thread. Compaction backs off while they do.
+	bool ForegroundTasksWaiting();
+	//! Called by a compaction task that stops, with the range of segments it did not get to
+	void FinishCompactionTask(idx_t start, idx_t end);
+
+private:
+	DatabaseInstance &db;
+	ColumnSegmentCatalogShard shards[NUM_SHARDS];
+
+	//! Lock for the compaction options below
+	mutex options_lock;
+	//! Wakes up the background thread early when the options change
+	std::condition_variable options_changed;
+	AdaptiveCompactionPolicy policy;
+	idx_t interval_ms;
+	double compaction_ratio;
+	idx_t target_memory;
+	double decode_budget;
+	double heat_decay;
+	double scan_weight;
+	idx_t hysteresis_rounds;
+	idx_t compaction_threads;
+
+	atomic<idx_t> compactions;
+	atomic<idx_t> uncompactions;
+	atomic<idx_t> avoided_transitions;
+	atomic<idx_t> compaction_time_ns;
+	atomic<idx_t> uncompaction_time_ns;
+	atomic<idx_t> rounds;
+	atomic<idx_t> reclaimed_segments;
+	atomic<idx_t> reclaimed_memory;
+	atomic<idx_t> delta_appends;
+	atomic<idx_t> delta_merges;
+	//! Set while a thread reclaims memory for the buffer manager
+	atomic<bool> reclaiming;
+	//! The number of segments ReclaimMemory can free memory from by compacting them or by spilling them
+	atomic<idx_t> reclaimable_segments;
+	atomic<idx_t> spillable_segments;
+	atomic<idx_t> spills;
+	atomic<idx_t> spilled_memory;
+	atomic<idx_t> spill_loads;
+	atomic<idx_t> prefetches;
+
+	atomic<bool> spill_enabled;
+	//! Lock for the spill file and the prefetch producer
+	mutex spill_lock;
+	shared_ptr<SegmentSpillFile> spill_file;
+	//! The producer the prefetch tasks are scheduled with
+	unique_ptr<ProducerToken> prefetch_producer;
+
+	atomic<bool> perf_events_enabled;
+	//! Hardware counters of the segment operations, indexed by kernel and bit width
+	SegmentKernelCounters kernel_counters[KERNEL_COUNT][65];
+
+	//! Additional nanoseconds per value for decoding a width compared to reading uncompressed data, indexed by width
+	double decode_cost_ns[65];
+	bool decode_costs_calibrated;
+
+	//! Lock for the state of the current compaction round below
+	mutex round_lock;
+	//! Signaled whenever a compaction task stops
+	std::condition_variable round_finished;
+	//! Ranges of segments of the current round that were not handed to a task yet
+	vector<pair<idx_t, idx_t>> pending_ranges;
+	//! Compaction tasks that were scheduled and did not stop yet
+	idx_t active_tasks;
+	//! Compaction tasks that were scheduled and not picked up by a thread yet
+	atomic<idx_t> queued_tasks;
+	//! Prefetch tasks that were scheduled and not picked up by a thread yet
+	atomic<idx_t> queued_prefetches;
+
+	unique_ptr<thread> background_thread;
+	atomic<bool> shutting_down;
+	atomic<bool> background_thread_started;
+	atomic<bool> background_compaction_enabled;
+	atomic<bool> adaptive_compaction_enabled;
 	idx_t skip_length_mask = 8 - 1;
 };
 
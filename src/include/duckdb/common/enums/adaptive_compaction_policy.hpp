@@ -0,0 +1,22 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/enums/adaptive_compaction_policy.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/constants.hpp"
+
+namespace duckdb {
+
+enum class AdaptiveCompactionPolicy : uint8_t {
+	//! Compact a fixed share of the least accessed segments every round
+	FIXED_RATIO = 0,
+	//! Compact the segments with the lowest decode cost per saved byte until the memory target is met
+	COST_MODEL
+};
+
+} // namespace duckdb
@@ -0,0 +1,33 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/enums/succinct_encoding.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/constants.hpp"
+
+namespace duckdb {
+
+//! The encodings of a compacted in-memory segment, ordered by the cost of decoding them
+enum class SuccinctEncoding : uint8_t {
+	//! The values minus the minimum of the segment, bit packed
+	FRAME_OF_REFERENCE = 0,
+	//! FRAME_OF_REFERENCE with the width that minimizes the size. The values that do not fit are exceptions, which
+	//! are stored with their rows on the side and patched into the decoded values.
+	PATCHED_FRAME_OF_REFERENCE,
+	//! Bit packed codes into a sorted, bit packed dictionary of the distinct values
+	DICTIONARY,
+	//! The values and end rows of the runs, bit packed. Random access needs a binary search over the runs.
+	RUN_LENGTH,
+	//! The differences between consecutive values, bit packed, and every 64th value. Random access needs to sum up
+	//! the differences from the start of the block of 64 values.
+	DELTA
+};
+
+string SuccinctEncodingToString(SuccinctEncoding encoding);
+
+} // namespace duckdb
@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/perf_events.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/constants.hpp"
+
+namespace duckdb {
+
+//! Hardware performance counters of a piece of work
+struct PerfEventCounters {
+	idx_t cycles = 0;
+	idx_t instructions = 0;
+	//! Last level cache misses
+	idx_t llc_misses = 0;
+	idx_t branch_misses = 0;
+
+	PerfEventCounters operator-(const PerfEventCounters &other) const {
+		PerfEventCounters result;
+		result.cycles = cycles - other.cycles;
+		result.instructions = instructions - other.instructions;
+		result.llc_misses = llc_misses - other.llc_misses;
+		result.branch_misses = branch_misses - other.branch_misses;
+		return result;
+	}
+
+	PerfEventCounters &operator+=(const PerfEventCounters &other) {
+		cycles += other.cycles;
+		instructions += other.instructions;
+		llc_misses += other.llc_misses;
+		branch_misses += other.branch_misses;
+		return *this;
+	}
+};
+
+//! The hardware performance counters of a thread, read through perf_event_open. The counters only count user space
+//! and are opened on the first use in a thread. If they cannot be opened (other platforms than Linux, a restrictive
+//! perf_event_paranoid, containers without access to the PMU) they always read zero.
+class ThreadPerfEvents {
+public:
+	ThreadPerfEvents();
+	~ThreadPerfEvents();
+
+	//! The counters of the calling thread
+	static ThreadPerfEvents &Get();
+
+	bool IsAvailable() const {
+		return leader_fd >= 0;
+	}
+	//! The current values of the counters, the work between two reads is their difference
+	PerfEventCounters Read();
+
+private:
+	static constexpr const idx_t EVENT_COUNT = 4;
+
+	//! The group leader, all counters of the group are read from it at once
+	int leader_fd;
+	//! The opened counters in the order they are read
+	int fds[EVENT_COUNT];
+	//! For every opened counter, which field of PerfEventCounters it is
+	idx_t fields[EVENT_COUNT];
+	idx_t opened_events;
+};
+
+//! Measures the counters of the calling thread from construction until Finish() is called
+class PerfEventMeasurement {
+public:
+	PerfEventMeasurement() : events(ThreadPerfEvents::Get()), start(events.Read()) {
+	}
+
+	PerfEventCounters Finish() {
+		return events.Read() - start;
+	}
+
+private:
+	ThreadPerfEvents &events;
+	PerfEventCounters start;
+};
+
+} // namespace duckdb
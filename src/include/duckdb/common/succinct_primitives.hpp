@@ -0,0 +1,488 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/succinct_primitives.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/types/selection_vector.hpp"
+
+namespace duckdb {
+
+using succinct_width_t = uint8_t;
+//! An unpack kernel of one type and width, see SuccinctPrimitives::GetUnPackFunction
+typedef void (*succinct_unpack_function_t)(data_ptr_t dst, const uint64_t *src, idx_t start, idx_t count,
+                                           uint64_t frame_of_reference);
+
+//! Bulk decoding of the bit layout used by sdsl::int_vector<>: values are stored back to back, least significant
+//! bit first, in an array of 64-bit words. A run of 64 values at width W therefore covers exactly W words, which
+//! lets the unpack loop work on fixed-size blocks with compile-time shifts and masks. At widths that are a multiple of
+//! 8 every value starts on a byte boundary: these are read with plain unaligned loads of the (little-endian) bytes.
+class SuccinctPrimitives {
+public:
+	static constexpr const idx_t SUCCINCT_BLOCK_SIZE = 64;
+	//! The number of rows FetchBuffer prefetches ahead
+	static constexpr const idx_t PREFETCH_DISTANCE = 8;
+
+	//! Unpacks 'count' values starting at element 'start' of 'src' into 'dst', adding 'frame_of_reference' to
+	//! every value. Values are truncated to T, matching the uint64_t -> T copy of the row-at-a-time path.
+	template <class T>
+	static void UnPackBuffer(T *__restrict dst, const uint64_t *__restrict src, idx_t start, idx_t count,
+	                         succinct_width_t width, uint64_t frame_of_reference) {
+		switch (width) {
+#define SUCCINCT_UNPACK_CASE(W)                                                                                        \
+	case W:                                                                                                            \
+		return UnPackTemplated<T, W>(dst, src, start, count, frame_of_reference);
+			SUCCINCT_UNPACK_CASE(1)
+			SUCCINCT_UNPACK_CASE(2)
+			SUCCINCT_UNPACK_CASE(3)
+			SUCCINCT_UNPACK_CASE(4)
+			SUCCINCT_UNPACK_CASE(5)
+			SUCCINCT_UNPACK_CASE(6)
+			SUCCINCT_UNPACK_CASE(7)
+			SUCCINCT_UNPACK_CASE(8)
+			SUCCINCT_UNPACK_CASE(9)
+			SUCCINCT_UNPACK_CASE(10)
+			SUCCINCT_UNPACK_CASE(11)
+			SUCCINCT_UNPACK_CASE(12)
+			SUCCINCT_UNPACK_CASE(13)
+			SUCCINCT_UNPACK_CASE(14)
+			SUCCINCT_UNPACK_CASE(15)
+			SUCCINCT_UNPACK_CASE(16)
+			SUCCINCT_UNPACK_CASE(17)
+			SUCCINCT_UNPACK_CASE(18)
+			SUCCINCT_UNPACK_CASE(19)
+			SUCCINCT_UNPACK_CASE(20)
+			SUCCINCT_UNPACK_CASE(21)
+			SUCCINCT_UNPACK_CASE(22)
+			SUCCINCT_UNPACK_CASE(23)
+			SUCCINCT_UNPACK_CASE(24)
+			SUCCINCT_UNPACK_CASE(25)
+			SUCCINCT_UNPACK_CASE(26)
+			SUCCINCT_UNPACK_CASE(27)
+			SUCCINCT_UNPACK_CASE(28)
+			SUCCINCT_UNPACK_CASE(29)
+			SUCCINCT_UNPACK_CASE(30)
+			SUCCINCT_UNPACK_CASE(31)
+			SUCCINCT_UNPACK_CASE(32)
+			SUCCINCT_UNPACK_CASE(33)
+			SUCCINCT_UNPACK_CASE(34)
+			SUCCINCT_UNPACK_CASE(35)
+			SUCCINCT_UNPACK_CASE(36)
+			SUCCINCT_UNPACK_CASE(37)
+			SUCCINCT_UNPACK_CASE(38)
+			SUCCINCT_UNPACK_CASE(39)
+			SUCCINCT_UNPACK_CASE(40)
+			SUCCINCT_UNPACK_CASE(41)
+			SUCCINCT_UNPACK_CASE(42)
+			SUCCINCT_UNPACK_CASE(43)
+			SUCCINCT_UNPACK_CASE(44)
+			SUCCINCT_UNPACK_CASE(45)
+			SUCCINCT_UNPACK_CASE(46)
+			SUCCINCT_UNPACK_CASE(47)
+			SUCCINCT_UNPACK_CASE(48)
+			SUCCINCT_UNPACK_CASE(49)
+			SUCCINCT_UNPACK_CASE(50)
+			SUCCINCT_UNPACK_CASE(51)
+			SUCCINCT_UNPACK_CASE(52)
+			SUCCINCT_UNPACK_CASE(53)
+			SUCCINCT_UNPACK_CASE(54)
+			SUCCINCT_UNPACK_CASE(55)
+			SUCCINCT_UNPACK_CASE(56)
+			SUCCINCT_UNPACK_CASE(57)
+			SUCCINCT_UNPACK_CASE(58)
+			SUCCINCT_UNPACK_CASE(59)
+			SUCCINCT_UNPACK_CASE(60)
+			SUCCINCT_UNPACK_CASE(61)
+			SUCCINCT_UNPACK_CASE(62)
+			SUCCINCT_UNPACK_CASE(63)
+			SUCCINCT_UNPACK_CASE(64)
+#undef SUCCINCT_UNPACK_CASE
+		default:
+			throw InternalException("Unsupported width %d for succinct unpacking", width);
+		}
+	}
+
+	//! Resolves the unpack kernel of 'width' once, for callers that decode many runs of values of the same width
+	template <class T>
+	static succinct_unpack_function_t GetUnPackFunction(succinct_width_t width) {
+		switch (width) {
+#define SUCCINCT_UNPACK_FUNCTION_CASE(W)                                                                               \
+	case W:                                                                                                            \
+		return UnPackUntyped<T, W>;
+			SUCCINCT_UNPACK_FUNCTION_CASE(1)
+			SUCCINCT_UNPACK_FUNCTION_CASE(2)
+			SUCCINCT_UNPACK_FUNCTION_CASE(3)
+			SUCCINCT_UNPACK_FUNCTION_CASE(4)
+			SUCCINCT_UNPACK_FUNCTION_CASE(5)
+			SUCCINCT_UNPACK_FUNCTION_CASE(6)
+			SUCCINCT_UNPACK_FUNCTION_CASE(7)
+			SUCCINCT_UNPACK_FUNCTION_CASE(8)
+			SUCCINCT_UNPACK_FUNCTION_CASE(9)
+			SUCCINCT_UNPACK_FUNCTION_CASE(10)
+			SUCCINCT_UNPACK_FUNCTION_CASE(11)
+			SUCCINCT_UNPACK_FUNCTION_CASE(12)
+			SUCCINCT_UNPACK_FUNCTION_CASE(13)
+			SUCCINCT_UNPACK_FUNCTION_CASE(14)
+			SUCCINCT_UNPACK_FUNCTION_CASE(15)
+			SUCCINCT_UNPACK_FUNCTION_CASE(16)
+			SUCCINCT_UNPACK_FUNCTION_CASE(17)
+			SUCCINCT_UNPACK_FUNCTION_CASE(18)
+			SUCCINCT_UNPACK_FUNCTION_CASE(19)
+			SUCCINCT_UNPACK_FUNCTION_CASE(20)
+			SUCCINCT_UNPACK_FUNCTION_CASE(21)
+			SUCCINCT_UNPACK_FUNCTION_CASE(22)
+			SUCCINCT_UNPACK_FUNCTION_CASE(23)
+			SUCCINCT_UNPACK_FUNCTION_CASE(24)
+			SUCCINCT_UNPACK_FUNCTION_CASE(25)
+			SUCCINCT_UNPACK_FUNCTION_CASE(26)
+			SUCCINCT_UNPACK_FUNCTION_CASE(27)
+			SUCCINCT_UNPACK_FUNCTION_CASE(28)
+			SUCCINCT_UNPACK_FUNCTION_CASE(29)
+			SUCCINCT_UNPACK_FUNCTION_CASE(30)
+			SUCCINCT_UNPACK_FUNCTION_CASE(31)
+			SUCCINCT_UNPACK_FUNCTION_CASE(32)
+			SUCCINCT_UNPACK_FUNCTION_CASE(33)
+			SUCCINCT_UNPACK_FUNCTION_CASE(34)
+			SUCCINCT_UNPACK_FUNCTION_CASE(35)
+			SUCCINCT_UNPACK_FUNCTION_CASE(36)
+			SUCCINCT_UNPACK_FUNCTION_CASE(37)
+			SUCCINCT_UNPACK_FUNCTION_CASE(38)
+			SUCCINCT_UNPACK_FUNCTION_CASE(39)
+			SUCCINCT_UNPACK_FUNCTION_CASE(40)
+			SUCCINCT_UNPACK_FUNCTION_CASE(41)
+			SUCCINCT_UNPACK_FUNCTION_CASE(42)
+			SUCCINCT_UNPACK_FUNCTION_CASE(43)
+			SUCCINCT_UNPACK_FUNCTION_CASE(44)
+			SUCCINCT_UNPACK_FUNCTION_CASE(45)
+			SUCCINCT_UNPACK_FUNCTION_CASE(46)
+			SUCCINCT_UNPACK_FUNCTION_CASE(47)
+			SUCCINCT_UNPACK_FUNCTION_CASE(48)
+			SUCCINCT_UNPACK_FUNCTION_CASE(49)
+			SUCCINCT_UNPACK_FUNCTION_CASE(50)
+			SUCCINCT_UNPACK_FUNCTION_CASE(51)
+			SUCCINCT_UNPACK_FUNCTION_CASE(52)
+			SUCCINCT_UNPACK_FUNCTION_CASE(53)
+			SUCCINCT_UNPACK_FUNCTION_CASE(54)
+			SUCCINCT_UNPACK_FUNCTION_CASE(55)
+			SUCCINCT_UNPACK_FUNCTION_CASE(56)
+			SUCCINCT_UNPACK_FUNCTION_CASE(57)
+			SUCCINCT_UNPACK_FUNCTION_CASE(58)
+			SUCCINCT_UNPACK_FUNCTION_CASE(59)
+			SUCCINCT_UNPACK_FUNCTION_CASE(60)
+			SUCCINCT_UNPACK_FUNCTION_CASE(61)
+			SUCCINCT_UNPACK_FUNCTION_CASE(62)
+			SUCCINCT_UNPACK_FUNCTION_CASE(63)
+			SUCCINCT_UNPACK_FUNCTION_CASE(64)
+#undef SUCCINCT_UNPACK_FUNCTION_CASE
+		default:
+			throw InternalException("Unsupported width %d for succinct unpacking", width);
+		}
+	}
+
+	//! Packs 'count' values of 'src' at 'width' bits into 'dst' (which has to be zero-initialized), subtracting
+	//! 'frame_of_reference' from every value first. The inverse of UnPackBuffer.
+	template <class T>
+	static void PackBuffer(uint64_t *__restrict dst, const T *__restrict src, idx_t count, succinct_width_t width,
+	                       uint64_t frame_of_reference) {
+		const uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+		uint64_t bit_pos = 0;
+		for (idx_t i = 0; i < count; i++, bit_pos += width) {
+			uint64_t value = (uint64_t(src[i]) - frame_of_reference) & mask;
+			uint64_t *word = dst + (bit_pos >> 6);
+			const uint64_t offset = bit_pos & 63;
+			word[0] |= value << offset;
+			if (offset + width > 64) {
+				word[1] |= value >> (64 - offset);
+			}
+		}
+	}
+
+	//! Returns the packed value at 'index', without frame of reference.
+	static inline uint64_t UnPackValue(const uint64_t *__restrict src, idx_t index, succinct_width_t width) {
+		const uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+		const uint64_t bit_pos = index * width;
+		const uint64_t *word = src + (bit_pos >> 6);
+		const uint64_t offset = bit_pos & 63;
+		uint64_t value = word[0] >> offset;
+		if (offset + width > 64) {
+			value |= word[1] << (64 - offset);
+		}
+		return value & mask;
+	}
+
+	//! Unpacks the values at the (arbitrary) indexes 'row_ids' of 'src' into 'dst', adding 'frame_of_reference' to
+	//! every value. The word of the value PREFETCH_DISTANCE rows ahead is prefetched, so the cache misses of an index
+	//! lookup hitting many rows of a large segment overlap instead of being paid one after the other.
+	template <class T>
+	static void FetchBuffer(T *__restrict dst, const uint64_t *__restrict src, const row_t *__restrict row_ids,
+	                        idx_t count, succinct_width_t width, uint64_t frame_of_reference) {
+		switch (width) {
+#define SUCCINCT_FETCH_CASE(W)                                                                                         \
+	case W:                                                                                                            \
+		return FetchByteAligned<T, W / 8>(dst, src, row_ids, count, frame_of_reference);
+			SUCCINCT_FETCH_CASE(8)
+			SUCCINCT_FETCH_CASE(16)
+			SUCCINCT_FETCH_CASE(24)
+			SUCCINCT_FETCH_CASE(32)
+			SUCCINCT_FETCH_CASE(40)
+			SUCCINCT_FETCH_CASE(48)
+			SUCCINCT_FETCH_CASE(56)
+#undef SUCCINCT_FETCH_CASE
+		default:
+			break;
+		}
+		for (idx_t i = 0; i < count; i++) {
+			if (i + PREFETCH_DISTANCE < count) {
+				Prefetch(src + ((row_ids[i + PREFETCH_DISTANCE] * width) >> 6));
+			}
+			dst[i] = T(UnPackValue(src, row_ids[i], width) + frame_of_reference);
+		}
+	}
+
+	static inline void Prefetch(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(address);
+#else
+		(void)address;
+#endif
+	}
+
+	//! Selects the candidate rows of 'sel' (relative to 'start') whose packed value p satisfies
+	//! OP::Operation(p, constant) without decoding them to the column type. Returns the number of selected rows.
+	template <class OP>
+	static idx_t SelectBuffer(const uint64_t *__restrict src, idx_t start, const SelectionVector &sel,
+	                          idx_t approved_count, succinct_width_t width, uint64_t constant,
+	                          SelectionVector &result_sel) {
+		switch (width) {
+#define SUCCINCT_SELECT_CASE(W)                                                                                        \
+	case W:                                                                                                            \
+		return SelectByteAligned<OP, W / 8>(src, start, sel, approved_count, constant, result_sel);
+			SUCCINCT_SELECT_CASE(8)
+			SUCCINCT_SELECT_CASE(16)
+			SUCCINCT_SELECT_CASE(24)
+			SUCCINCT_SELECT_CASE(32)
+			SUCCINCT_SELECT_CASE(40)
+			SUCCINCT_SELECT_CASE(48)
+			SUCCINCT_SELECT_CASE(56)
+#undef SUCCINCT_SELECT_CASE
+		default:
+			break;
+		}
+		idx_t result_count = 0;
+		for (idx_t i = 0; i < approved_count; i++) {
+			auto idx = sel.get_index(i);
+			if (OP::Operation(UnPackValue(src, start + idx, width), constant)) {
+				result_sel.set_index(result_count++, idx);
+			}
+		}
+		return result_count;
+	}
+
+	//! SWAR (in)equality test of 'count' rows starting at 'start' for widths that divide 64: every word holds a
+	//! whole number of values, which are all compared against the constant at once.
+	template <bool EQUALS>
+	static idx_t SelectEqualsSWAR(const uint64_t *__restrict src, idx_t start, idx_t count, succinct_width_t width,
+	                              uint64_t constant, SelectionVector &result_sel) {
+		D_ASSERT(64 % width == 0);
+		const idx_t lanes = 64 / width;
+		const uint64_t lane_mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+		// the lowest and the highest bit of every lane
+		const uint64_t lane_ones = ~uint64_t(0) / lane_mask;
+		const uint64_t high_bits = lane_ones << (width - 1);
+		const uint64_t low_bits = ~high_bits;
+		const uint64_t pattern = (constant & lane_mask) * lane_ones;
+
+		idx_t result_count = 0;
+		const idx_t end = start + count;
+		for (idx_t word_idx = start / lanes; word_idx * lanes < end; word_idx++) {
+			const uint64_t x = src[word_idx] ^ pattern;
+			// the high bit of a lane is set iff the lane is zero, i.e. the value equals the constant
+			const uint64_t zero_lanes = ~(((x & low_bits) + low_bits) | x | low_bits);
+			const uint64_t matches = EQUALS ? zero_lanes : (~zero_lanes & high_bits);
+			if (!matches) {
+				continue;
+			}
+			for (idx_t lane = 0; lane < lanes; lane++) {
+				const idx_t row = word_idx * lanes + lane;
+				if ((matches >> (lane * width + width - 1)) & 1 && row >= start && row < end) {
+					result_sel.set_index(result_count++, row - start);
+				}
+			}
+		}
+		return result_count;
+	}
+
+	//! The largest width SumPacked is used for: it costs 'width' popcounts per word, unpacking is cheaper beyond
+	static constexpr const succinct_width_t SUM_PACKED_MAX_WIDTH = 8;
+
+	//! Sums 'count' packed values starting at 'start' without unpacking them. Every bit plane (bit j of all values) is
+	//! counted with popcounts: bit i of word w is bit (64 * w + i) % width of its value, so the planes of a word are
+	//! the masks of the bits i with i % width == k, shifted by the phase (64 * w) % width. The caller guarantees that
+	//! the sum fits into 64 bits.
+	static uint64_t SumPacked(const uint64_t *__restrict src, idx_t start, idx_t count, succinct_width_t width) {
+		D_ASSERT(width > 0 && width <= 64);
+		uint64_t plane_masks[64];
+		idx_t plane_counts[64];
+		for (idx_t k = 0; k < width; k++) {
+			plane_masks[k] = 0;
+			for (idx_t bit = k; bit < 64; bit += width) {
+				plane_masks[k] |= uint64_t(1) << bit;
+			}
+			plane_counts[k] = 0;
+		}
+		const idx_t begin_bit = start * width;
+		const idx_t end_bit = (start + count) * width;
+		for (idx_t word_idx = begin_bit / 64; word_idx * 64 < end_bit; word_idx++) {
+			const idx_t word_start = word_idx * 64;
+			uint64_t word = src[word_idx];
+			// the first and the last word may hold bits of values outside of the range
+			if (word_start < begin_bit) {
+				word &= ~uint64_t(0) << (begin_bit - word_start);
+			}
+			if (end_bit - word_start < 64) {
+				word &= (uint64_t(1) << (end_bit - word_start)) - 1;
+			}
+			const idx_t phase = word_start % width;
+			for (idx_t k = 0; k < width; k++) {
+				idx_t plane = phase + k;
+				plane = plane >= width ? plane - width : plane;
+				plane_counts[plane] += PopCount(word & plane_masks[k]);
+			}
+		}
+		uint64_t sum = 0;
+		for (idx_t plane = 0; plane < width; plane++) {
+			sum += uint64_t(plane_counts[plane]) << plane;
+		}
+		return sum;
+	}
+
+	static inline idx_t PopCount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_popcountll(word);
+#else
+		word = word - ((word >> 1) & 0x5555555555555555ULL);
+		word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+		word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return (word * 0x0101010101010101ULL) >> 56;
+#endif
+	}
+
+	//! Returns the width needed to store every value in [0, range], optionally rounded up to whole bytes.
+	static succinct_width_t MinimumBitWidth(uint64_t range, bool pad_to_byte) {
+		succinct_width_t width = 1;
+		while (range >>= 1) {
+			width++;
+		}
+		if (pad_to_byte) {
+			width = (width + 7) & ~7;
+		}
+		return width;
+	}
+
+	//! Returns the number of bytes an int_vector with 'count' values of 'width' bits occupies.
+	static idx_t GetRequiredSize(idx_t count, succinct_width_t width) {
+		// the packed words plus the serialized header of the int_vector (size and width)
+		return GetPackedSize(count, width) + sizeof(uint64_t) + sizeof(uint8_t);
+	}
+
+	//! Returns the number of bytes of the packed words for 'count' values of 'width' bits.
+	static idx_t GetPackedSize(idx_t count, succinct_width_t width) {
+		return ((count * width + 63) / 64) * sizeof(uint64_t);
+	}
+
+private:
+	//! Loads the BYTES bytes of the byte aligned value at 'index'. Only the bytes of the value are read, so this never
+	//! reads past the end of the packed words.
+	template <idx_t BYTES>
+	static inline uint64_t LoadBytes(const uint64_t *__restrict src, idx_t index) {
+		uint64_t value = 0;
+		memcpy(&value, (const_data_ptr_t)src + index * BYTES, BYTES);
+		return value;
+	}
+
+	template <class T, idx_t BYTES>
+	static void FetchByteAligned(T *__restrict dst, const uint64_t *__restrict src, const row_t *__restrict row_ids,
+	                             idx_t count, uint64_t frame_of_reference) {
+		auto bytes = (const_data_ptr_t)src;
+		for (idx_t i = 0; i < count; i++) {
+			if (i + PREFETCH_DISTANCE < count) {
+				Prefetch(bytes + row_ids[i + PREFETCH_DISTANCE] * BYTES);
+			}
+			dst[i] = T(LoadBytes<BYTES>(src, row_ids[i]) + frame_of_reference);
+		}
+	}
+
+	template <class OP, idx_t BYTES>
+	static idx_t SelectByteAligned(const uint64_t *__restrict src, idx_t start, const SelectionVector &sel,
+	                               idx_t approved_count, uint64_t constant, SelectionVector &result_sel) {
+		idx_t result_count = 0;
+		for (idx_t i = 0; i < approved_count; i++) {
+			auto idx = sel.get_index(i);
+			if (OP::Operation(LoadBytes<BYTES>(src, start + idx), constant)) {
+				result_sel.set_index(result_count++, idx);
+			}
+		}
+		return result_count;
+	}
+
+	template <class T, succinct_width_t WIDTH>
+	static inline T UnPackSingle(const uint64_t *__restrict src, uint64_t bit_pos, uint64_t frame_of_reference) {
+		static constexpr const uint64_t MASK = WIDTH == 64 ? ~uint64_t(0) : (uint64_t(1) << (WIDTH % 64)) - 1;
+		const uint64_t *word = src + (bit_pos >> 6);
+		const uint64_t offset = bit_pos & 63;
+		uint64_t value = word[0] >> offset;
+		if (offset + WIDTH > 64) {
+			// the value straddles two words: fetch the high bits from the next one
+			value |= word[1] << (64 - offset);
+		}
+		return T((value & MASK) + frame_of_reference);
+	}
+
+	template <class T, succinct_width_t WIDTH>
+	static void UnPackUntyped(data_ptr_t dst, const uint64_t *src, idx_t start, idx_t count,
+	                          uint64_t frame_of_reference) {
+		UnPackTemplated<T, WIDTH>((T *)dst, src, start, count, frame_of_reference);
+	}
+
+	template <class T, succinct_width_t WIDTH>
+	static void UnPackTemplated(T *__restrict dst, const uint64_t *__restrict src, idx_t start, idx_t count,
+	                            uint64_t frame_of_reference) {
+		if (WIDTH % 8 == 0 && WIDTH < 64) {
+			// byte aligned: no shifting or straddling words, the loop is a plain widening copy
+			for (idx_t i = 0; i < count; i++) {
+				dst[i] = T(LoadBytes<WIDTH / 8>(src, start + i) + frame_of_reference);
+			}
+			return;
+		}
+		// the loops run over the absolute row 'k', which keeps their bounds provable for the compiler
+		const idx_t end = start + count;
+		// decode up to the next block boundary one value at a time
+		const idx_t misaligned_end =
+		    MinValue<idx_t>(end, start + (SUCCINCT_BLOCK_SIZE - start % SUCCINCT_BLOCK_SIZE) % SUCCINCT_BLOCK_SIZE);
+		idx_t k = start;
+		for (; k < misaligned_end; k++) {
+			dst[k - start] = UnPackSingle<T, WIDTH>(src, k * WIDTH, frame_of_reference);
+		}
+		// full blocks: every block starts on a word boundary, so all shifts are compile-time constants
+		const idx_t blocks_end = k + (end - k) / SUCCINCT_BLOCK_SIZE * SUCCINCT_BLOCK_SIZE;
+		for (; k < blocks_end; k += SUCCINCT_BLOCK_SIZE) {
+			const uint64_t *block = src + (k / SUCCINCT_BLOCK_SIZE) * WIDTH;
+			T *out = dst + (k - start);
+			for (idx_t j = 0; j < SUCCINCT_BLOCK_SIZE; j++) {
+				out[j] = UnPackSingle<T, WIDTH>(block, j * WIDTH, frame_of_reference);
+			}
+		}
+		for (; k < end; k++) {
+			dst[k - start] = UnPackSingle<T, WIDTH>(src, k * WIDTH, frame_of_reference);
+		}
+	}
+};
+
+} // namespace duckdb
@@ -15,6 +15,7 @@
 #include "duckdb/parser/group_by_node.hpp"
 #include "duckdb/execution/radix_partitioned_hashtable.hpp"
 #include "duckdb/common/unordered_map.hpp"
+#include "duckdb/storage/table/aggregate_pushdown.hpp"
 
 namespace duckdb {
 
@@ -29,6 +30,9 @@ public:
 	vector<unique_ptr<Expression>> aggregates;
 	unique_ptr<DistinctAggregateData> distinct_data;
 	unique_ptr<DistinctAggregateCollectionInfo> distinct_collection_info;
+	//! The aggregates that the table scan below computes on the compressed data (if any), combined with the results
+	//! of the operator when finalizing
+	shared_ptr<AggregatePushdown> aggregate_pushdown;
 
 public:
 	// Source interface
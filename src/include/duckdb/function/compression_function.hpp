@@ -14,6 +14,8 @@
 #include "duckdb/common/map.hpp"
 #include "duckdb/storage/storage_info.hpp"
 #include "duckdb/common/mutex.hpp"
+#include "duckdb/common/limits.hpp"
+#include "duckdb/common/types/hugeint.hpp"
 
 namespace duckdb {
 class DatabaseInstance;
@@ -21,6 +23,7 @@ class ColumnData;
 class ColumnDataCheckpointer;
 class ColumnSegment;
 class SegmentStatistics;
+class TableFilter;
 
 struct ColumnFetchState;
 struct ColumnScanState;
@@ -50,6 +53,88 @@ struct CompressionAppendState {
 	BufferHandle handle;
 };
 
+//! The SUM, MIN and MAX of a range of integer values, computed on the compressed data of a segment
+struct SegmentAggregate {
+	explicit SegmentAggregate(bool needs_sum = true, bool needs_min_max = true)
+	    : needs_sum(needs_sum), needs_min_max(needs_min_max) {
+		Reset();
+	}
+
+	//! Which of the aggregates are needed, a compression function can skip computing the others
+	bool needs_sum;
+	bool needs_min_max;
+	//! The number of aggregated values
+	idx_t count;
+	hugeint_t sum;
+	hugeint_t min;
+	hugeint_t max;
+
+public:
+	void Reset() {
+		count = 0;
+		sum = 0;
+		min = NumericLimits<hugeint_t>::Maximum();
+		max = NumericLimits<hugeint_t>::Minimum();
+	}
+
+	//! Add 'repeat' times the same value
+	void Add(const hugeint_t &value, idx_t repeat) {
+		count += repeat;
+		if (needs_sum) {
+			sum += value * hugeint_t(int64_t(repeat));
+		}
+		if (needs_min_max) {
+			min = value < min ? value : min;
+			max = value > max ? value : max;
+		}
+	}
+
+	//! Add 'value_count' decoded values
+	template <class T>
+	void AddValues(const T *values, idx_t value_count) {
+		if (value_count == 0) {
+			return;
+		}
+		count += value_count;
+		if (needs_sum) {
+			if (sizeof(T) < sizeof(int64_t)) {
+				// narrower values cannot overflow a 64-bit sum of a block of values
+				int64_t block_sum = 0;
+				for (idx_t i = 0; i < value_count; i++) {
+					block_sum += int64_t(values[i]);
+				}
+				sum += hugeint_t(block_sum);
+			} else {
+				for (idx_t i = 0; i < value_count; i++) {
+					sum += Hugeint::Convert(values[i]);
+				}
+			}
+		}
+		if (needs_min_max) {
+			T min_value = values[0];
+			T max_value = values[0];
+			for (idx_t i = 1; i < value_count; i++) {
+				min_value = values[i] < min_value ? values[i] : min_value;
+				max_value = values[i] > max_value ? values[i] : max_value;
+			}
+			auto block_min = Hugeint::Convert(min_value);
+			auto block_max = Hugeint::Convert(max_value);
+			min = block_min < min ? block_min : min;
+			max = block_max > max ? block_max : max;
+		}
+	}
+
+	void Combine(const SegmentAggregate &other) {
+		if (other.count == 0) {
+			return;
+		}
+		count += other.count;
+		sum += other.sum;
+		min = other.min < min ? other.min : min;
+		max = other.max > max ? other.max : max;
+	}
+};
+
 //===--------------------------------------------------------------------===//
 // Analyze
 //===--------------------------------------------------------------------===//
@@ -88,9 +173,23 @@ typedef void (*compression_scan_partial_t)(ColumnSegment &segment, ColumnScanSta
 //! Function prototype used for reading a single value
 typedef void (*compression_fetch_row_t)(ColumnSegment &segment, ColumnFetchState &state, row_t row_id, Vector &result,
                                         idx_t result_idx);
+//! Function prototype used for reading the values of 'count' rows at once (optional). The row ids are relative to the
+//! start of the segment, the value of row_ids[i] is written to result[result_offset + i].
+typedef void (*compression_fetch_rows_t)(ColumnSegment &segment, ColumnFetchState &state, const row_t *row_ids,
+                                         idx_t count, Vector &result, idx_t result_offset);
 //! Function prototype used for skipping 'skip_count' values, non-trivial if random-access is not supported for the
 //! compressed data.
 typedef void (*compression_skip_t)(ColumnSegment &segment, ColumnScanState &state, idx_t skip_count);
+//! Function prototype used for evaluating a table filter directly on the compressed data of 'scan_count' values
+//! (optional). Refines 'sel'/'approved_tuple_count' and writes the values of the qualifying rows to 'result'. NULLs
+//! are not taken into account. Returns false, without touching any of the outputs, if the filter is not supported.
+typedef bool (*compression_filter_t)(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, Vector &result,
+                                     const TableFilter &filter, SelectionVector &sel, idx_t &approved_tuple_count);
+//! Function prototype used for aggregating 'scan_count' values starting at the current row of the scan directly on
+//! the compressed data (optional). Does not move the scan forward. NULLs are not taken into account. Returns false,
+//! without touching 'result', if the values cannot be aggregated this way.
+typedef bool (*compression_aggregate_t)(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count,
+                                        SegmentAggregate &result);
 
 //===--------------------------------------------------------------------===//
 // Append (optional)
@@ -113,12 +212,14 @@ public:
 	                    compression_init_segment_t init_segment = nullptr,
 	                    compression_init_append_t init_append = nullptr, compression_append_t append = nullptr,
 	                    compression_finalize_append_t finalize_append = nullptr,
-	                    compression_revert_append_t revert_append = nullptr)
+	                    compression_revert_append_t revert_append = nullptr,
+	                    compression_filter_t filter = nullptr, compression_fetch_rows_t fetch_rows = nullptr,
+	                    compression_aggregate_t aggregate = nullptr)
 	    : type(type), data_type(data_type), init_analyze(init_analyze), analyze(analyze), final_analyze(final_analyze),
 	      init_compression(init_compression), compress(compress), compress_finalize(compress_finalize),
 	      init_scan(init_scan), scan_vector(scan_vector), scan_partial(scan_partial), fetch_row(fetch_row), skip(skip),
 	      init_segment(init_segment), init_append(init_append), append(append), finalize_append(finalize_append),
-	      revert_append(revert_append) {
+	      revert_append(revert_append), filter(filter), fetch_rows(fetch_rows), aggregate(aggregate) {
 	}
 
 	//! Compression type
@@ -174,6 +275,15 @@ public:
 	compression_finalize_append_t finalize_append;
 	//! Revert append (optional)
 	compression_revert_append_t revert_append;
+
+	//! Evaluate a table filter on the compressed data (optional)
+	compression_filter_t filter;
+	//! Fetch a batch of rows from the compressed vector (optional), falls back to fetch_row
+	//! used for index lookups that hit several rows of the same segment
+	compression_fetch_rows_t fetch_rows;
+	//! Compute the SUM, MIN and MAX of a range of the compressed values (optional)
+	//! used for ungrouped aggregates over table scans
+	compression_aggregate_t aggregate;
 };
 
 //! The set of compression functions
@@ -53,6 +53,10 @@ struct DuckDBColumnsFun {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
 
+struct DuckDBCompactionStatisticsFun {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
 struct DuckDBConstraintsFun {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
@@ -69,6 +73,10 @@ struct DuckDBFunctionsFun {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
 
+struct DuckDBKernelCountersFun {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
 struct DuckDBKeywordsFun {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
@@ -77,6 +85,10 @@ struct DuckDBIndexesFun {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
 
+struct DuckDBSegmentHeatFun {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
 struct DuckDBSequencesFun {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
@@ -13,6 +13,7 @@
 #include "duckdb/function/built_in_functions.hpp"
 
 namespace duckdb {
+class AggregatePushdown;
 class TableCatalogEntry;
 
 struct TableScanBindData : public TableFunctionData {
@@ -28,6 +29,8 @@ struct TableScanBindData : public TableFunctionData {
 	bool is_create_index;
 	//! The row ids to fetch (in case of an index scan)
 	vector<row_t> result_ids;
+	//! The ungrouped aggregates computed by the scan on the compressed data (if any), set by the planner
+	shared_ptr<AggregatePushdown> aggregate_pushdown;
 
 public:
 	bool Equals(const FunctionData &other_p) const override {
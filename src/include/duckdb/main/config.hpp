@@ -11,6 +11,7 @@
 #include "duckdb/common/allocator.hpp"
 #include "duckdb/common/case_insensitive_map.hpp"
 #include "duckdb/common/common.hpp"
+#include "duckdb/common/enums/adaptive_compaction_policy.hpp"
 #include "duckdb/common/enums/compression_type.hpp"
 #include "duckdb/common/enums/optimizer_type.hpp"
 #include "duckdb/common/enums/order_type.hpp"
@@ -188,13 +189,37 @@ public:
 
 	//! Enable usage of succinct compression for in memory data.
 	bool succinct_enabled = true;
-	//! Extract prefix from succinct compression.
-	bool succinct_extract_prefix_enabled = true;
 	//! Enable succinct compression and pad to the next byte.
 	bool succinct_padded_to_next_byte_enabled = false;
+	//! Rebase compacted integer segments on a frame of reference and width shared by their column.
+	bool succinct_shared_frame_enabled = false;
 	//! Enable adaptive succinct compression using background thread on rarely used
 	//! segments.
 	bool adaptive_succinct_compression_enabled = false;
+	//! Policy the background thread uses to decide which segments to compact.
+	AdaptiveCompactionPolicy adaptive_compaction_policy = AdaptiveCompactionPolicy::FIXED_RATIO;
+	//! Time between two background compaction rounds (in milliseconds).
+	idx_t adaptive_compaction_interval = 10000;
+	//! Share of the least accessed segments compacted by the fixed ratio policy.
+	double adaptive_compaction_ratio = 0.90;
+	//! Memory usage the cost model policy tries to stay under (in bytes). Default: no target.
+	idx_t adaptive_compaction_target_memory = (idx_t)-1;
+	//! Share of a compaction interval the cost model may spend on additional decoding of compacted segments.
+	double adaptive_compaction_decode_budget = 0.05;
+	//! Weight of the past rounds in the access heat of a segment (0: only the last round counts).
+	double adaptive_compaction_heat_decay = 0.5;
+	//! Weight of a vector read by a scan in the heat of a segment, relative to a qualifying read or a fetched row.
+	double adaptive_compaction_scan_weight = 0.1;
+	//! Move the vectors of very cold compacted segments to a spill file in the temporary directory.
+	bool adaptive_compaction_spill_enabled = false;
+	//! Number of consecutive rounds a segment must be classified cold (hot) before it is compacted (uncompacted).
+	idx_t adaptive_compaction_hysteresis_rounds = 2;
+	//! Maximum number of threads that (un)compact segments at the same time during a compaction round.
+	idx_t adaptive_compaction_threads = 1;
+	//! Measure the hardware performance counters of the segment operations and of the profiled operators.
+	bool perf_events_enabled = false;
+	//! Compute ungrouped SUM, MIN, MAX and COUNT aggregates of table scans on the compressed data of the segments.
+	bool aggregate_pushdown_enabled = true;
 
 public:
 	DUCKDB_API static DBConfig &GetConfig(ClientContext &context);
@@ -23,6 +23,7 @@ class ConnectionManager;
 class FileSystem;
 class TaskScheduler;
 class ObjectCache;
+class ColumnSegmentCatalog;
 
 class DatabaseInstance : public std::enable_shared_from_this<DatabaseInstance> {
 	friend class DuckDB;
@@ -41,6 +42,7 @@ public:
 	DUCKDB_API ObjectCache &GetObjectCache();
 	DUCKDB_API ConnectionManager &GetConnectionManager();
 	DUCKDB_API ValidChecker &GetValidChecker();
+	DUCKDB_API ColumnSegmentCatalog &GetColumnSegmentCatalog();
 	DUCKDB_API void SetExtensionLoaded(const std::string &extension_name);
 
 	idx_t NumberOfThreads();
@@ -57,6 +59,8 @@ private:
 	void Configure(DBConfig &config);
 
 private:
+	//! Declared first: the segments of all attached databases unregister themselves from it when they are destroyed
+	unique_ptr<ColumnSegmentCatalog> column_segment_catalog;
 	unique_ptr<BufferManager> buffer_manager;
 	unique_ptr<DatabaseManager> db_manager;
 	unique_ptr<TaskScheduler> scheduler;
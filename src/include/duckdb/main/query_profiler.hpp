@@ -10,6 +10,7 @@
 
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/enums/profiler_format.hpp"
+#include "duckdb/common/perf_events.hpp"
 #include "duckdb/common/profiler.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
@@ -88,6 +89,8 @@ struct OperatorInformation {
 
 	double time = 0;
 	idx_t elements = 0;
+	//! The hardware counters of the operator, if perf_events_enabled is set
+	PerfEventCounters perf_events;
 	string name;
 	//! A vector of Expression Executor Info
 	vector<unique_ptr<ExpressionExecutorInfo>> executors_info;
@@ -98,7 +101,7 @@ class OperatorProfiler {
 	friend class QueryProfiler;
 
 public:
-	DUCKDB_API explicit OperatorProfiler(bool enabled);
+	DUCKDB_API explicit OperatorProfiler(bool enabled, bool perf_events_enabled = false);
 
 	DUCKDB_API void StartOperator(const PhysicalOperator *phys_op);
 	DUCKDB_API void EndOperator(DataChunk *chunk);
@@ -109,12 +112,16 @@ public:
 	}
 
 private:
-	void AddTiming(const PhysicalOperator *op, double time, idx_t elements);
+	void AddTiming(const PhysicalOperator *op, double time, idx_t elements, const PerfEventCounters &perf_events);
 
 	//! Whether or not the profiler is enabled
 	bool enabled;
+	//! Whether the hardware counters of the operators are measured as well
+	bool perf_events_enabled;
 	//! The timer used to time the execution time of the individual Physical Operators
 	Profiler op;
+	//! The hardware counters of the thread when the active operator started
+	PerfEventCounters op_perf_events;
 	//! The stack of Physical Operators that are currently active
 	const PhysicalOperator *active_operator;
 	//! A mapping of physical operators to recorded timings
@@ -25,6 +25,127 @@ struct AccessModeSetting {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct AdaptiveCompactionDecodeBudgetSetting {
+	static constexpr const char *Name = "adaptive_compaction_decode_budget";
+	static constexpr const char *Description =
+	    "Share of a compaction interval the cost model policy may add as decoding time of compacted segments";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::DOUBLE;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct AdaptiveCompactionHeatDecaySetting {
+	static constexpr const char *Name = "adaptive_compaction_heat_decay";
+	static constexpr const char *Description =
+	    "Weight of past compaction rounds in the access heat of a segment (0 only counts the last round)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::DOUBLE;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct AdaptiveCompactionHysteresisRoundsSetting {
+	static constexpr const char *Name = "adaptive_compaction_hysteresis_rounds";
+	static constexpr const char *Description =
+	    "Number of consecutive compaction rounds a segment must stay cold (hot) before it is compacted (uncompacted)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BIGINT;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct AdaptiveCompactionIntervalSetting {
+	static constexpr const char *Name = "adaptive_compaction_interval";
+	static constexpr const char *Description = "Time between two adaptive compaction rounds in milliseconds";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BIGINT;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct AdaptiveCompactionPolicySetting {
+	static constexpr const char *Name = "adaptive_compaction_policy";
+	static constexpr const char *Description =
+	    "Policy used to pick the segments to compact in the background (FIXED_RATIO or COST_MODEL)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::VARCHAR;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct AdaptiveCompactionRatioSetting {
+	static constexpr const char *Name = "adaptive_compaction_ratio";
+	static constexpr const char *Description =
+	    "Share of the segments the fixed ratio policy keeps compacted, the least read ones first";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::DOUBLE;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct AdaptiveCompactionScanWeightSetting {
+	static constexpr const char *Name = "adaptive_compaction_scan_weight";
+	static constexpr const char *Description =
+	    "Weight of a vector read by a scan in the access heat of a segment, relative to a vector with rows matching a "
+	    "filter or a fetched row (0 keeps scans from heating up segments)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::DOUBLE;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct AdaptiveCompactionSpillEnabledSetting {
+	static constexpr const char *Name = "adaptive_compaction_spill_enabled";
+	static constexpr const char *Description =
+	    "Move very cold compacted segments, and the coldest compacted segments when the memory limit is reached, to a "
+	    "spill file in the temporary directory. They are loaded again when they are read.";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct AdaptiveCompactionTargetMemorySetting {
+	static constexpr const char *Name = "adaptive_compaction_target_memory";
+	static constexpr const char *Description =
+	    "The memory usage the cost model policy compacts segments to stay under (e.g. 1GB)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::VARCHAR;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct AdaptiveCompactionThreadsSetting {
+	static constexpr const char *Name = "adaptive_compaction_threads";
+	static constexpr const char *Description =
+	    "Maximum number of threads that (un)compact segments at the same time during an adaptive compaction round";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BIGINT;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct AdaptiveSuccinctCompressionEnabledSetting {
+	static constexpr const char *Name = "adaptive_succinct_compression_enabled";
+	static constexpr const char *Description =
+	    "Compact in-memory segments in a background thread based on how often they are read, not when full or scanned";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct AggregatePushdownEnabledSetting {
+	static constexpr const char *Name = "aggregate_pushdown_enabled";
+	static constexpr const char *Description =
+	    "Compute ungrouped SUM, MIN, MAX and COUNT aggregates of table scans on the compressed data of the segments";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
 struct CheckpointThresholdSetting {
 	static constexpr const char *Name = "checkpoint_threshold";
 	static constexpr const char *Description =
@@ -301,6 +422,17 @@ struct PasswordSetting {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct PerfEventsEnabledSetting {
+	static constexpr const char *Name = "perf_events_enabled";
+	static constexpr const char *Description =
+	    "Measure the hardware performance counters (cycles, instructions, cache and branch misses) of the segment "
+	    "operations and of the profiled operators";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
 struct PerfectHashThresholdSetting {
 	static constexpr const char *Name = "perfect_ht_threshold";
 	static constexpr const char *Description = "Threshold in bytes for when to use a perfect hash table (default: 12)";
@@ -389,6 +521,36 @@ struct SearchPathSetting {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct SuccinctEnabledSetting {
+	static constexpr const char *Name = "succinct_enabled";
+	static constexpr const char *Description =
+	    "Whether new in-memory segments of numeric columns may be stored as succinct vectors";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct SuccinctPaddedToNextByteEnabledSetting {
+	static constexpr const char *Name = "succinct_padded_to_next_byte_enabled";
+	static constexpr const char *Description =
+	    "Whether the bit width of succinct vectors is rounded up to whole bytes";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct SuccinctSharedFrameEnabledSetting {
+	static constexpr const char *Name = "succinct_shared_frame_enabled";
+	static constexpr const char *Description =
+	    "Whether compacted integer segments share the frame of reference and bit width of their column";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static void ResetGlobal(DatabaseInstance *db, DBConfig &config);
+	static Value GetSetting(ClientContext &context);
+};
+
 struct TempDirectorySetting {
 	static constexpr const char *Name = "temp_directory";
 	static constexpr const char *Description = "Set the directory to which to write temp files";
@@ -63,6 +63,8 @@ public:
 	void SetThreads(int32_t n);
 	//! Returns the number of threads
 	int32_t NumberOfThreads();
+	//! Returns the (approximate) number of scheduled tasks that no thread has picked up yet
+	idx_t NumberOfQueuedTasks();
 
 	//! Send signals to n threads, signalling for them to wake up and attempt to execute a task
 	void Signal(idx_t n);
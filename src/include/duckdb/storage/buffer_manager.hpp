@@ -68,12 +68,15 @@ public:
 		return maximum_memory;
 	}
 
+	//! Account for memory of segment data that is allocated outside of the buffer manager (the in-memory succinct
+	//! vectors), so the memory limit applies to it
 	void AddToDataSize(int64_t new_data) {
 		current_memory += new_data;
 		data_size += new_data;
 	}
 
-	void AddOnlyToDataSize(idx_t new_data) {
+	//! Account for segment data that is already charged to the buffer manager as a block
+	void AddOnlyToDataSize(int64_t new_data) {
 		data_size += new_data;
 	}
 
@@ -158,7 +161,8 @@ private:
 	void VerifyZeroReaders(shared_ptr<BlockHandle> &handle);
 
 private:
-	idx_t data_size;
+	//! The memory used by the data of the segments (in bytes)
+	atomic<idx_t> data_size;
 	//! The database instance
 	DatabaseInstance &db;
 	//! The lock for changing the memory limit
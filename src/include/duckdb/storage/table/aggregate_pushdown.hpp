@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/storage/table/aggregate_pushdown.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/function/compression_function.hpp"
+
+namespace duckdb {
+
+enum class PushdownAggregateType : uint8_t { COUNT_STAR = 0, COUNT = 1, SUM = 2, MIN = 3, MAX = 4 };
+
+//! An ungrouped aggregate that is computed by a table scan
+struct PushdownAggregate {
+	PushdownAggregate(PushdownAggregateType type, idx_t column_index) : type(type), column_index(column_index) {
+	}
+
+	PushdownAggregateType type;
+	//! The index of the aggregated column in the column ids of the scan (unused for COUNT(*))
+	idx_t column_index;
+};
+
+//! The ungrouped aggregates of an AGGREGATE(SEQ_SCAN) plan that the scan computes on the compressed data of the
+//! vectors that allow it (see ColumnData::AggregateCompressed). These vectors are not emitted by the scan: the
+//! aggregate operator combines the results of the scan with its own results of the remaining vectors.
+class AggregatePushdown {
+public:
+	AggregatePushdown(vector<PushdownAggregate> aggregates, idx_t column_count);
+
+	//! The aggregates, in the order of the aggregate operator
+	vector<PushdownAggregate> aggregates;
+	//! For every column of the scan: whether it is aggregated, and which aggregates of its values are needed
+	vector<bool> aggregated;
+	vector<bool> needs_sum;
+	vector<bool> needs_min_max;
+
+public:
+	//! Clear the results of a previous execution
+	void Reset();
+	//! Add the results of a scan
+	void Combine(idx_t row_count, const vector<SegmentAggregate> &column_aggregates);
+	//! Combine the result of the aggregate operator for the aggregate at 'aggr_idx' with the result of the scans
+	Value Finalize(idx_t aggr_idx, const Value &result);
+
+	//! The partial aggregates of a column, initialized with the aggregates it needs
+	SegmentAggregate InitializeColumn(idx_t column_index) const;
+
+private:
+	mutex lock;
+	//! The number of rows that were aggregated by the scans
+	idx_t row_count;
+	//! The aggregates of the values of every column
+	vector<SegmentAggregate> column_aggregates;
+};
+
+//! The partial aggregates of a single (parallel) scan, added to the AggregatePushdown once the scan is done
+struct AggregatePushdownState {
+	explicit AggregatePushdownState(AggregatePushdown &pushdown);
+
+	AggregatePushdown &pushdown;
+	//! The number of rows aggregated by the scan
+	idx_t row_count;
+	//! The aggregates of the values of every column
+	vector<SegmentAggregate> column_aggregates;
+	//! The aggregates of the vector that is currently aggregated, only added if all columns could be aggregated
+	vector<SegmentAggregate> vector_aggregates;
+
+public:
+	void Flush();
+};
+
+} // namespace duckdb
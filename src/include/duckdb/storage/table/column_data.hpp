@@ -21,11 +21,13 @@
 namespace duckdb {
 class ColumnData;
 class ColumnSegment;
+class ColumnSuccinctMetadata;
 class DatabaseInstance;
 class RowGroup;
 class RowGroupWriter;
 class TableDataWriter;
 struct TransactionData;
+struct SegmentAggregate;
 
 struct DataTableInfo;
 
@@ -58,6 +60,9 @@ public:
 
 public:
 	virtual bool CheckZonemap(ColumnScanState &state, TableFilter &filter) = 0;
+	//! Whether the segments following the current segment of the scan can contain rows before end_row that pass the
+	//! filter
+	virtual bool CheckZonemapRange(ColumnScanState &state, idx_t end_row, TableFilter &filter);
 
 	DatabaseInstance &GetDatabase() const;
 	DataTableInfo &GetTableInfo() const;
@@ -80,6 +85,15 @@ public:
 	//! Select
 	virtual void Select(TransactionData transaction, idx_t vector_index, ColumnScanState &state, Vector &result,
 	                    SelectionVector &sel, idx_t &count, const TableFilter &filter);
+	//! Evaluate the filter on the compressed data of the next vector without scanning it, if the vector lies in a
+	//! single segment whose compression function supports it. NULLs are not taken into account. Returns false if
+	//! the filter could not be evaluated this way.
+	bool SelectCompressed(TransactionData transaction, idx_t vector_index, ColumnScanState &state, Vector &result,
+	                      SelectionVector &sel, idx_t &count, const TableFilter &filter);
+	//! Aggregate the next 'count' rows of the scan on the compressed data without scanning them, if they lie in a
+	//! single segment whose compression function supports it. Does not move the scan forward. Returns false if the
+	//! rows could not be aggregated this way.
+	virtual bool AggregateCompressed(ColumnScanState &state, idx_t count, SegmentAggregate &result);
 	virtual void FilterScan(TransactionData transaction, idx_t vector_index, ColumnScanState &state, Vector &result,
 	                        SelectionVector &sel, idx_t count);
 	virtual void FilterScanCommitted(idx_t vector_index, ColumnScanState &state, Vector &result, SelectionVector &sel,
@@ -101,6 +115,10 @@ public:
 	//! Fetch a specific row id and append it to the vector
 	virtual void FetchRow(TransactionData transaction, ColumnFetchState &state, row_t row_id, Vector &result,
 	                      idx_t result_idx);
+	//! Fetch 'count' row ids and write them to the vector starting at 'result_offset'. The rows of a segment are
+	//! fetched at once.
+	virtual void FetchRows(TransactionData transaction, ColumnFetchState &state, const row_t *row_ids, idx_t count,
+	                       Vector &result, idx_t result_offset);
 
 	virtual void Update(TransactionData transaction, idx_t column_index, Vector &update_vector, row_t *row_ids,
 	                    idx_t update_count);
@@ -138,6 +156,8 @@ protected:
 	//! Append a transient segment
 	void AppendTransientSegment(SegmentLock &l, idx_t start_row);
 
+	//! Positions the scan state at the start of the next vector to scan
+	void BeginScanVectorInternal(ColumnScanState &state);
 	//! Scans a base vector from the column
 	idx_t ScanVector(ColumnScanState &state, Vector &result, idx_t remaining);
 	//! Scans a vector from the column merged with any potential updates
@@ -154,6 +174,8 @@ protected:
 	unique_ptr<UpdateSegment> updates;
 	//! The internal version of the column data
 	idx_t version;
+	//! The frame of reference and width shared by the compacted segments of an integer column (nullptr otherwise)
+	shared_ptr<ColumnSuccinctMetadata> succinct_metadata;
 };
 
 } // namespace duckdb
@@ -13,10 +13,13 @@
 #include "duckdb/common/types.hpp"
 #include "duckdb/common/types/vector.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/catalog/catalog_entry/column_segment_catalog.hpp"
 #include "duckdb/storage/statistics/segment_statistics.hpp"
 #include "duckdb/storage/storage_lock.hpp"
 #include "duckdb/storage/table/scan_state.hpp"
+#include "duckdb/storage/table/segment_representation.hpp"
 #include "duckdb/function/compression_function.hpp"
+#include "duckdb/common/atomic.hpp"
 #include <sdsl/vectors.hpp>
 #include <mutex>
 
@@ -26,6 +29,7 @@ class ColumnSegment;
 class BlockManager;
 class ColumnSegment;
 class ColumnData;
+class ColumnSuccinctMetadata;
 class DatabaseInstance;
 class Transaction;
 class BaseStatistics;
@@ -34,6 +38,7 @@ class TableFilter;
 struct ColumnFetchState;
 struct ColumnScanState;
 struct ColumnAppendState;
+struct SharedSuccinctFrame;
 
 enum class ColumnSegmentType : uint8_t { TRANSIENT, PERSISTENT };
 //! TableFilter represents a filter pushed down into the table scan.
@@ -57,29 +62,57 @@ public:
 	//! The block that this segment relates to
 	shared_ptr<BlockHandle> block;
 
-	sdsl::int_vector<> succinct_vec;
 	//! If succinct compression is possible and enabled, e.g. its an integer column.
 	bool succinct_possible;
 	//! If segment actually contains the data and is not a validity vector.
 	bool is_data_segment;
+	//! Read counters used by the adaptive compaction, updated without locking on every scan and fetch.
+	AccessStatistics access_statistics;
+	//! Set while a task that loads the spilled segment ahead of a scan is scheduled
+	atomic<bool> prefetch_scheduled;
+	//! The number of compaction and prefetch tasks that work on the segment after they released the lock of its
+	//! registry shard, guarded by that lock. The destructor waits until they are done.
+	idx_t catalog_pins;
+	//! The succinct metadata shared with the other segments of the column, nullptr if the segment does not share a
+	//! frame of reference (it is not compactable, or not an integer segment)
+	shared_ptr<ColumnSuccinctMetadata> column_metadata;
 
 	static unique_ptr<ColumnSegment> CreatePersistentSegment(DatabaseInstance &db, BlockManager &block_manager,
 	                                                         block_id_t id, idx_t offset, const LogicalType &type_p,
 	                                                         idx_t start, idx_t count, CompressionType compression_type,
 	                                                         unique_ptr<BaseStatistics> statistics);
+	//! Create an in-memory segment. Only 'compactable' segments (the ones table appends go to) may be stored as, or
+	//! compacted into, an in-memory succinct vector; the others are plain buffers written by compression functions.
 	static unique_ptr<ColumnSegment> CreateTransientSegment(DatabaseInstance &db, const LogicalType &type, idx_t start,
-	                                                        idx_t segment_size = Storage::BLOCK_SIZE);
+	                                                        idx_t segment_size = Storage::BLOCK_SIZE,
+	                                                        bool compactable = false);
 	static unique_ptr<ColumnSegment> CreateSegment(ColumnSegment &other, idx_t start);
 
 public:
 	void InitializeScan(ColumnScanState &state);
 	//! Scan one vector from this segment
 	void Scan(ColumnScanState &state, idx_t scan_count, Vector &result, idx_t result_offset, bool entire_vector);
+	//! Scan 'scan_count' values with the unpack kernel of the shared frame of the column, if the representation the
+	//! scan reads was compacted with that frame. 'shared_frames' holds the unpadded and the padded frame. Returns false
+	//! (without scanning) otherwise.
+	bool ScanShared(ColumnScanState &state, const shared_ptr<const SharedSuccinctFrame> shared_frames[],
+	                idx_t scan_count, Vector &result, idx_t result_offset);
 	//! Fetch a value of the specific row id and append it to the result
 	void FetchRow(ColumnFetchState &state, row_t row_id, Vector &result, idx_t result_idx);
+	//! Fetch the values of 'count' row ids of this segment and write them to the result starting at 'result_offset'
+	void FetchRows(ColumnFetchState &state, const row_t *row_ids, idx_t count, Vector &result, idx_t result_offset);
 
 	static idx_t FilterSelection(SelectionVector &sel, Vector &result, const TableFilter &filter,
 	                             idx_t &approved_tuple_count, ValidityMask &mask);
+	//! Evaluate the filter on the compressed data of 'scan_count' values, if the compression function supports it.
+	//! Returns false if it does not, the caller then has to scan and filter the values.
+	bool FilterCompressed(ColumnScanState &state, idx_t scan_count, Vector &result, const TableFilter &filter,
+	                      SelectionVector &sel, idx_t &approved_tuple_count);
+	//! Count a scanned vector of this segment in which a filter found matching rows as a read access
+	void RecordQualifyingRead();
+	//! Aggregate 'scan_count' values starting at the current row of the scan on the compressed data, if the
+	//! compression function supports it. Does not move the scan forward, returns false if it is not supported.
+	bool AggregateCompressed(ColumnScanState &state, idx_t scan_count, SegmentAggregate &result);
 
 	//! Skip a scan forward to the row_index specified in the scan state
 	void Skip(ColumnScanState &state);
@@ -91,6 +124,11 @@ public:
 
 	idx_t SuccinctSize() const;
 
+	//! The bit width ('width') and the size of the succinct representation ('size') the segment has (if compacted),
+	//! or an estimate of them based on the segment statistics for a compaction with 'pad_to_byte'. The statistics are
+	//! updated by appends: returns false without waiting if an append or a compaction of the segment is running.
+	bool TryEstimateSuccinctSize(bool pad_to_byte, uint8_t &width, idx_t &size);
+
 	//! Resize the block
 	void Resize(idx_t segment_size);
 
@@ -136,57 +174,102 @@ public:
 		return segment_state.get();
 	}
 
-	uint64_t GetMinFactor() {
-		return min_factor;
-	}
-
-	uint64_t GetMax() {
-		return max_factor;
+	//! The current representation of a compactable segment (nullptr for all other segments). Safe to call
+	//! concurrently with Compact and Uncompact.
+	shared_ptr<SegmentRepresentation> GetRepresentation() const {
+		return std::atomic_load(&representation);
 	}
 
-	void UpdateMinFactor(uint64_t new_min) {
-		min_factor = std::min(min_factor, new_min);
-		//std::cout << "Update min with " << new_min << " and store as " << min_factor << std::endl;
-	}
-
-	void UpdateMaxFactor(uint64_t new_max) {
-		max_factor = std::max(max_factor, new_max);
-		//std::cout << "Update max with " << new_max << " and store as " << max_factor << std::endl;
+	//! Whether the values of this succinct segment live in succinct_vec. Otherwise (persistent segments and segments
+	//! written during a checkpoint) they are stored in the block in the on-disk succinct format.
+	bool HasSuccinctVector() const {
+		return succinct_possible && function->type == CompressionType::COMPRESSION_SUCCINCT;
 	}
 
 	bool IsBitCompressed() {
 		return compacted;
 	}
 
-	void SetBitCompressed() {
-		compacted = true;
-	}
-
-	void SetBitUncompressed() {
-		compacted = false;
-	}
-
-	void Compact();
-
+	//! Switch the segment to a bit compressed succinct representation, using the smallest of the encodings up to
+	//! 'max_encoding'. With 'pad_to_byte' (or succinct_padded_to_next_byte_enabled) the widths are rounded up to whole
+	//! bytes. A compacted segment is re-encoded if it was compacted with other options. Never blocks scans.
+	void Compact(SuccinctEncoding max_encoding = SuccinctEncoding::FRAME_OF_REFERENCE, bool pad_to_byte = false);
+	//! Switch the segment back to its uncompressed representation. Never blocks scans.
 	void Uncompact();
+	//! Free memory for the buffer manager: compact the segment and drop its uncompressed block once no scan can read
+	//! it anymore. Returns 0 without waiting if an append or a compaction of the segment is running. Returns the
+	//! number of bytes freed.
+	idx_t ReclaimMemory();
+	//! Move the vectors of a compacted segment to the spill file and free their memory. A segment that was spilled
+	//! before and did not change since is dropped without writing it again. Returns 0 without waiting if an append or
+	//! a compaction of the segment is running, or if a scan still reads its uncompressed block. Returns the number of
+	//! bytes freed.
+	idx_t Spill();
+	//! Load the vectors of a spilled segment back into memory. Returns the current representation.
+	shared_ptr<SegmentRepresentation> LoadSpilled();
+	//! Whether the vectors of the segment are only stored in the spill file
+	bool IsSpilled() const {
+		auto current = GetRepresentation();
+		return current && current->spilled;
+	}
 
 public:
 	ColumnSegment(DatabaseInstance &db, shared_ptr<BlockHandle> block, LogicalType type, ColumnSegmentType segment_type,
 	              idx_t start, idx_t count, CompressionFunction *function, unique_ptr<BaseStatistics> statistics,
-	              block_id_t block_id, idx_t offset, idx_t segment_size, bool succinct_possible,
-	              bool background_compaction_enabled, bool is_data_segment);
+	              block_id_t block_id, idx_t offset, idx_t segment_size, bool succinct_possible, bool is_data_segment);
 
 	ColumnSegment(ColumnSegment &other, idx_t start);
 
 private:
 	void Scan(ColumnScanState &state, idx_t scan_count, Vector &result);
 	void ScanPartial(ColumnScanState &state, idx_t scan_count, Vector &result, idx_t result_offset);
-
-	void BitCompressFromSuccinct();
-	void BitCompressFromUncompressed();
-	void UncompressSuccinct();
+	//! Compact the segment if it compacts itself
+	void PrepareScan(ColumnScanState &state);
+	//! Whether the segment compacts itself on scans and appends. Otherwise it is only compacted by the background
+	//! compaction and to reclaim memory, which is always the case for string segments.
+	bool SelfCompacting() const;
+	//! Whether strings of the segment live in overflow blocks, which the dictionary of a compacted segment does not
+	//! hold. Such segments are not compacted.
+	bool HasOverflowStrings() const;
+	//! The compression function the scan state was initialized with
+	CompressionFunction &GetScanFunction(ColumnScanState &state);
+	//! Whether the hardware counters of the operations on this segment are measured (perf_events_enabled)
+	bool MeasureKernels() const;
+
+	//! Compact/Uncompact, the bit_compression_lock has to be held
+	void CompactInternal(SuccinctEncoding max_encoding = SuccinctEncoding::FRAME_OF_REFERENCE, bool pad_to_byte = false);
+	void UncompactInternal();
+	//! The bit width the segment has or would get when it is compacted, the bit_compression_lock has to be held
+	uint8_t EstimateSuccinctWidth(bool pad_to_byte);
+	//! Whether the representation was rebased on a shared frame of the column that has been widened since
+	bool SharedFrameChanged(const SegmentRepresentation &current) const;
+	//! Build a compacted representation of the current values
+	shared_ptr<SegmentRepresentation> BitCompress(const SegmentRepresentation &current, SuccinctEncoding max_encoding,
+	                                              bool pad_to_byte);
+	//! Decode the current representation into a new uncompressed block
+	void UncompressSuccinct(const SegmentRepresentation &current);
+	//! Make room for appending 'append_count' rows to the delta buffer of a compacted segment, packing the buffered
+	//! rows first if it would grow beyond MAX_DELTA_COUNT rows. Returns false if the rows have to be appended to the
+	//! uncompacted segment instead. The bit_compression_lock has to be held.
+	bool ReserveDelta(idx_t append_count);
+	//! Load a spilled representation, the bit_compression_lock has to be held
+	shared_ptr<SegmentRepresentation> LoadSpilledInternal();
+	//! Let another thread load the next segment if it is spilled, scans read the segments in order
+	void PrefetchNext();
+	//! Drop the uncompressed block of a compacted segment if no scan can read it anymore, the bit_compression_lock
+	//! has to be held. Returns the memory of the block.
+	idx_t ReleaseUncompressedBlock();
+	//! Atomically replace the current representation
+	void PublishRepresentation(shared_ptr<SegmentRepresentation> new_representation);
+	//! Update the counts of reclaimable and spillable segments of the catalog after the state of the segment changed.
+	//! The bit_compression_lock has to be held.
+	void UpdateReclaimState();
 
 private:
+	//! The largest number of rows appended to a compacted segment before they are packed, scans and filters on the
+	//! packed rows stay fast while an append is not a full decode and re-encode of the segment
+	static constexpr const idx_t MAX_DELTA_COUNT = 8 * STANDARD_VECTOR_SIZE;
+
 	idx_t num_elements;
 
 	//! The block id that this segment relates to (persistent segment only)
@@ -197,21 +280,23 @@ private:
 	idx_t segment_size;
 	//! Storage associated with the compressed segment
 	unique_ptr<CompressedSegmentState> segment_state;
-	//! Common min factor of all elements in this segment
-	uint64_t min_factor;
-	//! Max number in this segment.
-	uint64_t max_factor;
+	//! The current representation of a compactable segment, only accessed through std::atomic_load/atomic_store
+	shared_ptr<SegmentRepresentation> representation;
 	//! If the succinct vector is bit compressed.
-	bool compacted;
+	atomic<bool> compacted;
+	//! Whether the block holds the uncompressed values. Compaction leaves the block untouched, so uncompacting a segment
+	//! that has one only needs to swap the representation.
+	bool has_uncompressed_block;
+	//! The last representation that reads the uncompressed block. Scans pin the block after they took the
+	//! representation, so the block can only be dropped once this expired.
+	weak_ptr<SegmentRepresentation> block_representation;
 	//! Column Segment Catalog to track access patterns over time.
 	ColumnSegmentCatalog* column_segment_catalog;
-	//! Bit Compression Lock for adaptive compression using a background thread.
+	//! Whether the segment is counted as reclaimable or spillable by the catalog, see UpdateReclaimState
+	bool counted_reclaimable;
+	bool counted_spillable;
+	//! Serializes the changes of the representation (appends, compaction and uncompaction). Scans never take it.
 	std::mutex bit_compression_lock;
-	//! If background (adaptive) compaction is enabled or if we need to compact ourselves.
-	bool background_compaction_enabled;
-	//! If the scan state needs to be reinitialized due to switching from compacted to uncompacted
-	//! representation.
-	bool force_reinitializing_scan_state;
 };
 
 } // namespace duckdb
@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/storage/table/column_succinct_metadata.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/succinct_primitives.hpp"
+
+namespace duckdb {
+
+//! The frame of reference and width the compacted FRAME_OF_REFERENCE segments of a column can share. It covers the
+//! values of every segment rebased on it so far: 'frame_of_reference' is their minimum and 'maximum' their maximum,
+//! both stored as the (sign-extended) bits of the values. A published frame is never changed.
+struct SharedSuccinctFrame {
+	uint64_t frame_of_reference = 0;
+	uint64_t maximum = 0;
+	succinct_width_t width = 0;
+	//! Whether the width was rounded up to whole bytes
+	bool padded = false;
+	//! The unpack kernel of the type of the column at 'width', resolved once for all segments that use the frame
+	succinct_unpack_function_t unpack = nullptr;
+};
+
+//! The succinct metadata shared by the compactable segments of an integer column. The compaction rebases a segment on
+//! the shared frame of reference and width if that widens the segment by at most MAX_SHARED_WIDTH_OVERHEAD bits:
+//! scans then decode consecutive segments with the same kernel, instead of dispatching on the encoding and the width
+//! of every segment. Padded and unpadded segments have widths of their own, so each padding keeps its own frame.
+class ColumnSuccinctMetadata {
+public:
+	//! The largest number of bits a value of a segment may grow by to use the shared width
+	static constexpr const succinct_width_t MAX_SHARED_WIDTH_OVERHEAD = 2;
+
+	static bool TypeIsSupported(PhysicalType type) {
+		switch (type) {
+		case PhysicalType::INT8:
+		case PhysicalType::UINT8:
+		case PhysicalType::INT16:
+		case PhysicalType::UINT16:
+		case PhysicalType::INT32:
+		case PhysicalType::UINT32:
+		case PhysicalType::INT64:
+		case PhysicalType::UINT64:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	//! The shared frame of the segments compacted with 'padded', nullptr if no segment was rebased on one yet
+	shared_ptr<const SharedSuccinctFrame> GetFrame(bool padded) const {
+		return std::atomic_load(&frames[padded ? 1 : 0]);
+	}
+
+	//! Rebase a segment with the values [minimum, maximum] and (own) bit width 'width' that is compacted with
+	//! 'pad_to_byte' on the shared frame of that padding. The frame is widened to cover the values of the segment if
+	//! needed. Returns the frame to pack the segment with, or nullptr if it would widen the segment by more than
+	//! MAX_SHARED_WIDTH_OVERHEAD bits: the frame is then left as it is, so a single outlier segment does not end the
+	//! sharing of all other segments.
+	template <class T>
+	shared_ptr<const SharedSuccinctFrame> TryAddRange(T minimum, T maximum, succinct_width_t width, bool pad_to_byte) {
+		lock_guard<mutex> guard(lock);
+		auto &frame = frames[pad_to_byte ? 1 : 0];
+		auto current = GetFrame(pad_to_byte);
+		if (current) {
+			auto current_minimum = T(current->frame_of_reference);
+			auto current_maximum = T(current->maximum);
+			if (current_minimum <= minimum && current_maximum >= maximum) {
+				return current->width <= width + MAX_SHARED_WIDTH_OVERHEAD ? current : nullptr;
+			}
+			minimum = MinValue<T>(minimum, current_minimum);
+			maximum = MaxValue<T>(maximum, current_maximum);
+		}
+		// the width of SuccinctEncoder::GetValueWidth, so a segment rebased on the frame is packed at exactly 'width'
+		auto candidate_width = MinValue<succinct_width_t>(
+		    SuccinctPrimitives::MinimumBitWidth(uint64_t(maximum) - uint64_t(minimum), pad_to_byte), sizeof(T) * 8);
+		if (candidate_width > width + MAX_SHARED_WIDTH_OVERHEAD) {
+			return nullptr;
+		}
+		auto result = make_shared<SharedSuccinctFrame>();
+		result->frame_of_reference = uint64_t(minimum);
+		result->maximum = uint64_t(maximum);
+		result->width = candidate_width;
+		result->padded = pad_to_byte;
+		result->unpack = SuccinctPrimitives::GetUnPackFunction<T>(result->width);
+		shared_ptr<const SharedSuccinctFrame> published = move(result);
+		std::atomic_store(&frame, published);
+		return published;
+	}
+
+private:
+	//! Serializes the changes of the frames, scans read them without locking
+	mutex lock;
+	//! The frames of the unpadded and the padded segments, only accessed through std::atomic_load/atomic_store
+	shared_ptr<const SharedSuccinctFrame> frames[2];
+};
+
+} // namespace duckdb
@@ -43,6 +43,8 @@ public:
 	idx_t Fetch(ColumnScanState &state, row_t row_id, Vector &result) override;
 	void FetchRow(TransactionData transaction, ColumnFetchState &state, row_t row_id, Vector &result,
 	              idx_t result_idx) override;
+	void FetchRows(TransactionData transaction, ColumnFetchState &state, const row_t *row_ids, idx_t count,
+	               Vector &result, idx_t result_offset) override;
 	void Update(TransactionData transaction, idx_t column_index, Vector &update_vector, row_t *row_ids,
 	            idx_t update_count) override;
 	void UpdateColumn(TransactionData transaction, const vector<column_t> &column_path, Vector &update_vector,
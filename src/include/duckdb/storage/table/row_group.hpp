@@ -20,6 +20,7 @@
 #include "sdsl/vectors.hpp"
 
 namespace duckdb {
+struct AggregatePushdownState;
 class AttachedDatabase;
 class BlockManager;
 class ColumnData;
@@ -122,6 +123,9 @@ public:
 	//! Fetch a specific row from the row_group and insert it into the result at the specified index
 	void FetchRow(TransactionData transaction, ColumnFetchState &state, const vector<column_t> &column_ids,
 	              row_t row_id, DataChunk &result, idx_t result_idx);
+	//! Fetch 'count' rows from the row_group and insert them into the result starting at 'result_offset'
+	void FetchRows(TransactionData transaction, ColumnFetchState &state, const vector<column_t> &column_ids,
+	               const row_t *row_ids, idx_t count, DataChunk &result, idx_t result_offset);
 
 	//! Append count rows to the version info
 	void AppendVersionInfo(TransactionData transaction, idx_t count);
@@ -163,6 +167,9 @@ private:
 
 	template <TableScanType TYPE>
 	void TemplatedScan(TransactionData transaction, RowGroupScanState &state, DataChunk &result);
+	//! Aggregate the next 'count' rows of the aggregated columns of the scan on the compressed data. Returns false,
+	//! without adding anything to the aggregates of the scan, if any of the columns could not be aggregated this way.
+	bool AggregateCompressed(RowGroupScanState &state, AggregatePushdownState &aggregate_pushdown, idx_t count);
 
 	static void CheckpointDeletes(VersionNode *versions, Serializer &serializer);
 	static shared_ptr<VersionNode> DeserializeDeletes(Deserializer &source);
@@ -14,6 +14,7 @@
 #include "duckdb/common/enums/scan_options.hpp"
 #include "duckdb/execution/adaptive_filter.hpp"
 #include "duckdb/storage/table/segment_lock.hpp"
+#include "duckdb/storage/table/aggregate_pushdown.hpp"
 
 namespace duckdb {
 class ColumnSegment;
@@ -28,6 +29,7 @@ class ColumnSegment;
 class ValiditySegment;
 class TableFilterSet;
 class ColumnData;
+struct SegmentRepresentation;
 
 struct SegmentScanState {
 	virtual ~SegmentScanState() {
@@ -50,12 +52,16 @@ struct ColumnScanState {
 	idx_t internal_index = 0;
 	//! Segment scan state
 	unique_ptr<SegmentScanState> scan_state;
+	//! The representation of a compactable segment the scan state was initialized on
+	shared_ptr<SegmentRepresentation> representation;
 	//! Child states of the vector
 	vector<ColumnScanState> child_states;
 	//! Whether or not InitializeState has been called for this segment
 	bool initialized = false;
 	//! If this segment has already been checked for skipping purposes
 	bool segment_checked = false;
+	//! If the zonemap of this segment has excluded all of its rows, reading it does not count as an access
+	bool segment_pruned = false;
 	//! The version of the column data that we are scanning.
 	//! This is used to detect if the ColumnData has been changed out from under us during a scan
 	//! If this is the case, we re-initialize the scan
@@ -78,6 +84,8 @@ struct ColumnFetchState {
 	buffer_handle_set_t handles;
 	//! Any child states of the fetch
 	vector<unique_ptr<ColumnFetchState>> child_states;
+	//! The representation of the compactable segment that is currently being fetched from
+	shared_ptr<SegmentRepresentation> representation;
 
 	BufferHandle &GetOrInsertHandle(ColumnSegment &segment);
 };
@@ -101,6 +109,7 @@ public:
 	const vector<column_t> &GetColumnIds();
 	TableFilterSet *GetFilters();
 	AdaptiveFilter *GetAdaptiveFilter();
+	AggregatePushdownState *GetAggregatePushdown();
 	idx_t GetParentMaxRow();
 
 private:
@@ -124,6 +133,7 @@ public:
 	const vector<column_t> &GetColumnIds();
 	TableFilterSet *GetFilters();
 	AdaptiveFilter *GetAdaptiveFilter();
+	AggregatePushdownState *GetAggregatePushdown();
 	bool Scan(Transaction &transaction, DataChunk &result);
 	bool ScanCommitted(DataChunk &result, TableScanType type);
 
@@ -141,11 +151,13 @@ public:
 	CollectionScanState local_state;
 
 public:
-	void Initialize(vector<column_t> column_ids, TableFilterSet *table_filters = nullptr);
+	void Initialize(vector<column_t> column_ids, TableFilterSet *table_filters = nullptr,
+	                AggregatePushdown *aggregate_pushdown = nullptr);
 
 	const vector<column_t> &GetColumnIds();
 	TableFilterSet *GetFilters();
 	AdaptiveFilter *GetAdaptiveFilter();
+	AggregatePushdownState *GetAggregatePushdown();
 
 private:
 	//! The column identifiers of the scan
@@ -154,6 +166,8 @@ private:
 	TableFilterSet *table_filters;
 	//! Adaptive filter info (if any)
 	unique_ptr<AdaptiveFilter> adaptive_filter;
+	//! The aggregates computed by the scan (if any)
+	unique_ptr<AggregatePushdownState> aggregate_pushdown;
 };
 
 struct ParallelCollectionScanState {
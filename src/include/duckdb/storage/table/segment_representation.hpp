@@ -0,0 +1,706 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/storage/table/segment_representation.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/enums/succinct_encoding.hpp"
+#include "duckdb/common/operator/comparison_operators.hpp"
+#include "duckdb/common/succinct_primitives.hpp"
+#include "duckdb/common/types/null_value.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include <sdsl/vectors.hpp>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace duckdb {
+class CompressionFunction;
+struct SegmentSpillRegion;
+
+//! The representation the values of a compactable segment are read from. A published representation is never changed
+//! by a compaction (appends only write rows no scan can see yet): Compact and Uncompact build a new one off to the
+//! side and swap the pointer. Scans and fetches keep the representation they started on alive, the old succinct vector
+//! is freed once the last of them releases it. Appends to a compacted segment go to its delta buffer, the rows after
+//! 'packed_count'.
+struct SegmentRepresentation {
+	//! The compression function that reads this representation
+	CompressionFunction *function;
+	//! The values, if they are stored in an in-memory succinct vector. For DICTIONARY, RUN_LENGTH and DELTA these are
+	//! the dictionary codes, the values of the runs or the differences.
+	shared_ptr<sdsl::int_vector<>> succinct_vec;
+	//! The dictionary (DICTIONARY), the end rows of the runs (RUN_LENGTH), every 64th value (DELTA) or the rows of the
+	//! exceptions (PATCHED_FRAME_OF_REFERENCE). For strings it holds the end of every string of the dictionary.
+	shared_ptr<sdsl::int_vector<>> auxiliary_vec;
+	//! The values of the exceptions of PATCHED_FRAME_OF_REFERENCE, minus the frame of reference
+	shared_ptr<sdsl::int_vector<>> exception_vec;
+	//! The bytes of the distinct strings of a compacted VARCHAR segment, sorted and concatenated
+	shared_ptr<sdsl::int_vector<>> string_vec;
+	//! Added to every value of the succinct vector (or of the dictionary, the runs or the blocks)
+	uint64_t frame_of_reference = 0;
+	//! Added to every difference of a DELTA encoded vector
+	uint64_t delta_frame_of_reference = 0;
+	//! Whether the succinct vector is bit compressed
+	bool compacted = false;
+	//! The encoding of the succinct vector
+	SuccinctEncoding encoding = SuccinctEncoding::FRAME_OF_REFERENCE;
+	//! FLOAT and DOUBLE values are stored as integers (value * 10^decimal_exponent) if they all convert back exactly.
+	//! Otherwise the succinct vector holds the bits of the values.
+	bool decimal_encoded = false;
+	uint8_t decimal_exponent = 0;
+	//! The integer NaNs (and thus NULLs) are stored as in a decimal encoded vector
+	int64_t nan_code = 0;
+	//! The most expensive encoding the compaction was allowed to choose
+	SuccinctEncoding max_encoding = SuccinctEncoding::FRAME_OF_REFERENCE;
+	//! Whether the widths were rounded up to whole bytes, which are decoded with plain loads instead of bit extraction
+	bool padded = false;
+	//! Whether the FRAME_OF_REFERENCE vector was rebased on the frame of reference and width shared by the column
+	bool shared_frame = false;
+	//! When the representation replaced the previous one of the segment
+	timestamp_t published_at = timestamp_t(0);
+	//! Whether the vectors were dropped from memory and only live in the spill region. Scans and fetches never read a
+	//! spilled representation, they load the vectors first (ColumnSegment::LoadSpilled).
+	bool spilled = false;
+	//! The width of the succinct vector while it is spilled
+	uint8_t spilled_width = 0;
+	//! The copy of the vectors in the spill file. A loaded representation keeps it, so the segment can be dropped
+	//! again without writing it.
+	shared_ptr<SegmentSpillRegion> spill_region;
+	//! The number of rows stored in the vectors of a compacted representation
+	idx_t packed_count = 0;
+	//! The rows appended since the segment was compacted, stored like in an uncompacted succinct vector (integers
+	//! truncated to the width of their type, FLOAT and DOUBLE values as their bits). Row 'packed_count' of the segment
+	//! is the first one. The next compaction folds them into the packed vectors.
+	shared_ptr<sdsl::int_vector<>> delta_vec;
+
+	//! The bit width of the succinct vector, 0 if the values are not stored in one
+	uint8_t GetWidth() const {
+		if (spilled) {
+			return spilled_width;
+		}
+		return succinct_vec ? succinct_vec->width() : 0;
+	}
+
+	//! The memory used by the vectors of the representation
+	idx_t SizeInBytes() const {
+		idx_t size = succinct_vec ? sdsl::size_in_bytes(*succinct_vec) : 0;
+		if (auxiliary_vec) {
+			size += sdsl::size_in_bytes(*auxiliary_vec);
+		}
+		if (exception_vec) {
+			size += sdsl::size_in_bytes(*exception_vec);
+		}
+		if (string_vec) {
+			size += sdsl::size_in_bytes(*string_vec);
+		}
+		if (delta_vec) {
+			size += sdsl::size_in_bytes(*delta_vec);
+		}
+		return size;
+	}
+};
+
+//! Builds and decodes the encodings of compacted in-memory segments.
+class SuccinctEncoder {
+public:
+	//! Builds the smallest of the encodings up to 'max_encoding' of 'count' integers. FRAME_OF_REFERENCE is rebased on
+	//! 'minimum' (the minimum of the valid values), which keeps the packed values ordered like the values themselves.
+	template <class T>
+	static void Encode(SegmentRepresentation &result, const T *values, idx_t count, T minimum, T maximum,
+	                   bool pad_to_byte, SuccinctEncoding max_encoding) {
+		static_assert(std::is_integral<T>::value, "Encode stores integers, use EncodeFloating for FLOAT and DOUBLE");
+		result.max_encoding = max_encoding;
+		result.padded = pad_to_byte;
+		result.encoding = SuccinctEncoding::FRAME_OF_REFERENCE;
+		auto for_width = GetValueWidth<T>(minimum, maximum, pad_to_byte);
+		idx_t best_size = SuccinctPrimitives::GetPackedSize(count, for_width);
+		if (max_encoding == SuccinctEncoding::FRAME_OF_REFERENCE || count == 0) {
+			EncodeFrameOfReference<T>(result, values, count, minimum, for_width);
+			return;
+		}
+
+		// the statistics cover all valid values, so the rows outside of them are NULL slots. They repeat the value of
+		// the row before, which keeps them from widening the other encodings, breaking runs or becoming exceptions.
+		vector<T> valid_values;
+		for (idx_t i = 0; i < count; i++) {
+			if (values[i] < minimum || values[i] > maximum) {
+				if (valid_values.empty()) {
+					valid_values.assign(values, values + count);
+				}
+				valid_values[i] = i == 0 ? minimum : valid_values[i - 1];
+			}
+		}
+		if (!valid_values.empty()) {
+			values = valid_values.data();
+		}
+
+		// the number of values of every width above the minimum, the wider ones are the exceptions of a narrower width
+		idx_t width_counts[65] = {};
+		for (idx_t i = 0; i < count; i++) {
+			width_counts[SuccinctPrimitives::MinimumBitWidth(uint64_t(values[i]) - uint64_t(minimum), false)]++;
+		}
+		auto position_width = SuccinctPrimitives::MinimumBitWidth(count - 1, pad_to_byte);
+		succinct_width_t patched_width = for_width;
+		idx_t patched_size = best_size;
+		idx_t exception_count = 0;
+		for (succinct_width_t width = for_width; width > 1; width--) {
+			exception_count += width_counts[width];
+			succinct_width_t candidate = width - 1;
+			if (pad_to_byte && candidate % 8 != 0) {
+				continue;
+			}
+			idx_t size = SuccinctPrimitives::GetPackedSize(count, candidate) +
+			             SuccinctPrimitives::GetPackedSize(exception_count, position_width) +
+			             SuccinctPrimitives::GetPackedSize(exception_count, for_width);
+			if (size < patched_size) {
+				patched_width = candidate;
+				patched_size = size;
+			}
+		}
+
+		T value_min = values[0];
+		T value_max = values[0];
+		idx_t run_count = 1;
+		int64_t delta_min = 0;
+		int64_t delta_max = 0;
+		for (idx_t i = 1; i < count; i++) {
+			value_min = MinValue<T>(value_min, values[i]);
+			value_max = MaxValue<T>(value_max, values[i]);
+			run_count += values[i] != values[i - 1];
+			// differences are computed (and added up again) on the sign-extended values modulo 2^64
+			auto delta = int64_t(uint64_t(values[i]) - uint64_t(values[i - 1]));
+			delta_min = i == 1 ? delta : MinValue<int64_t>(delta_min, delta);
+			delta_max = i == 1 ? delta : MaxValue<int64_t>(delta_max, delta);
+		}
+		auto value_width = GetValueWidth<T>(value_min, value_max, pad_to_byte);
+		auto delta_width = SuccinctPrimitives::MinimumBitWidth(uint64_t(delta_max) - uint64_t(delta_min), pad_to_byte);
+		auto run_end_width = SuccinctPrimitives::MinimumBitWidth(count, pad_to_byte);
+		idx_t block_count = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+		vector<T> dictionary;
+		if (max_encoding >= SuccinctEncoding::DICTIONARY) {
+			dictionary.assign(values, values + count);
+			std::sort(dictionary.begin(), dictionary.end());
+			dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+		}
+
+		// ties go to the encoding that is cheaper to decode
+		auto best_encoding = SuccinctEncoding::FRAME_OF_REFERENCE;
+		auto consider = [&](SuccinctEncoding encoding, idx_t size) {
+			if (encoding <= max_encoding && size < best_size) {
+				best_encoding = encoding;
+				best_size = size;
+			}
+		};
+		if (patched_width < for_width) {
+			consider(SuccinctEncoding::PATCHED_FRAME_OF_REFERENCE, patched_size);
+		}
+		if (!dictionary.empty()) {
+			auto code_width = SuccinctPrimitives::MinimumBitWidth(dictionary.size() - 1, pad_to_byte);
+			consider(SuccinctEncoding::DICTIONARY, SuccinctPrimitives::GetPackedSize(dictionary.size(), value_width) +
+			                                           SuccinctPrimitives::GetPackedSize(count, code_width));
+		}
+		consider(SuccinctEncoding::RUN_LENGTH, SuccinctPrimitives::GetPackedSize(run_count, value_width) +
+		                                           SuccinctPrimitives::GetPackedSize(run_count, run_end_width));
+		consider(SuccinctEncoding::DELTA, SuccinctPrimitives::GetPackedSize(count, delta_width) +
+		                                      SuccinctPrimitives::GetPackedSize(block_count, value_width));
+
+		switch (best_encoding) {
+		case SuccinctEncoding::FRAME_OF_REFERENCE:
+			EncodeFrameOfReference<T>(result, values, count, minimum, for_width);
+			break;
+		case SuccinctEncoding::PATCHED_FRAME_OF_REFERENCE:
+			EncodePatchedFrameOfReference<T>(result, values, count, minimum, patched_width, for_width,
+			                                 position_width);
+			break;
+		case SuccinctEncoding::DICTIONARY:
+			EncodeDictionary<T>(result, values, count, dictionary, value_min, value_width, pad_to_byte);
+			break;
+		case SuccinctEncoding::RUN_LENGTH:
+			EncodeRunLength<T>(result, values, count, run_count, value_min, value_width, run_end_width);
+			break;
+		case SuccinctEncoding::DELTA:
+			EncodeDelta<T>(result, values, count, value_min, value_width, uint64_t(delta_min), delta_width);
+			break;
+		}
+	}
+
+	//! Builds the representation of 'count' FLOAT or DOUBLE values. The values are stored as decimals if there is an
+	//! exponent at which all of them (but NaNs) convert to integers and back without loss, otherwise their bits are
+	//! stored.
+	template <class T>
+	static void EncodeFloating(SegmentRepresentation &result, const T *values, idx_t count, bool pad_to_byte,
+	                           SuccinctEncoding max_encoding) {
+		vector<int64_t> decimals(count);
+		for (uint8_t exponent = 0; exponent <= MAX_DECIMAL_EXPONENT; exponent++) {
+			if (TryConvertToDecimals<T>(values, count, exponent, decimals.data())) {
+				// NaNs are stored as the integer after the largest value
+				bool has_nan = false;
+				bool has_value = false;
+				int64_t minimum = 0;
+				int64_t maximum = 0;
+				for (idx_t i = 0; i < count; i++) {
+					if (IsNaNValue<T>(values[i])) {
+						has_nan = true;
+						continue;
+					}
+					minimum = has_value ? MinValue<int64_t>(minimum, decimals[i]) : decimals[i];
+					maximum = has_value ? MaxValue<int64_t>(maximum, decimals[i]) : decimals[i];
+					has_value = true;
+				}
+				result.decimal_encoded = true;
+				result.decimal_exponent = exponent;
+				result.nan_code = maximum + 1;
+				if (has_nan) {
+					for (idx_t i = 0; i < count; i++) {
+						if (IsNaNValue<T>(values[i])) {
+							decimals[i] = result.nan_code;
+						}
+					}
+					maximum = result.nan_code;
+				}
+				Encode<int64_t>(result, decimals.data(), count, minimum, maximum, pad_to_byte, max_encoding);
+				return;
+			}
+		}
+
+		typedef typename std::conditional<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>::type BITS;
+		auto bits = (const BITS *)values;
+		BITS minimum = count == 0 ? 0 : bits[0];
+		BITS maximum = minimum;
+		for (idx_t i = 1; i < count; i++) {
+			minimum = MinValue<BITS>(minimum, bits[i]);
+			maximum = MaxValue<BITS>(maximum, bits[i]);
+		}
+		result.decimal_encoded = false;
+		Encode<BITS>(result, bits, count, minimum, maximum, pad_to_byte, max_encoding);
+	}
+
+	//! Decodes 'count' values starting at row 'start' of an in-memory representation into 'dst'
+	template <class T>
+	static void Decode(const SegmentRepresentation &representation, idx_t start, idx_t count, T *__restrict dst) {
+		if (!representation.delta_vec || start + count <= representation.packed_count) {
+			DecodeValues<T>(representation, start, count, dst, std::is_floating_point<T>());
+			return;
+		}
+		// the rows after the packed ones are read from the delta buffer
+		idx_t packed = start < representation.packed_count ? representation.packed_count - start : 0;
+		if (packed > 0) {
+			DecodeValues<T>(representation, start, packed, dst, std::is_floating_point<T>());
+		}
+		typedef typename std::conditional<
+		    std::is_floating_point<T>::value,
+		    typename std::conditional<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>::type, T>::type STORED;
+		auto &delta = *representation.delta_vec;
+		SuccinctPrimitives::UnPackBuffer<STORED>((STORED *)(dst + packed), delta.data(),
+		                                         start + packed - representation.packed_count, count - packed,
+		                                         delta.width(), 0);
+	}
+
+	//! Decodes the values of the 'count' rows 'row_ids' of an in-memory representation into 'dst'. Every row is a
+	//! single lookup in a FRAME_OF_REFERENCE vector (plus a search of the exceptions for PATCHED_FRAME_OF_REFERENCE),
+	//! the other encodings (and representations with appended rows) decode the rows one by one.
+	template <class T>
+	static void Fetch(const SegmentRepresentation &representation, const row_t *row_ids, idx_t count,
+	                  T *__restrict dst) {
+		D_ASSERT(representation.succinct_vec);
+		bool patched = representation.encoding == SuccinctEncoding::PATCHED_FRAME_OF_REFERENCE;
+		if (std::is_floating_point<T>::value ||
+		    (representation.encoding != SuccinctEncoding::FRAME_OF_REFERENCE && !patched) ||
+		    representation.delta_vec) {
+			for (idx_t i = 0; i < count; i++) {
+				Decode<T>(representation, row_ids[i], 1, dst + i);
+			}
+			return;
+		}
+		auto &vec = *representation.succinct_vec;
+		SuccinctPrimitives::FetchBuffer<T>(dst, vec.data(), row_ids, count, vec.width(),
+		                                   representation.frame_of_reference);
+		if (!patched) {
+			return;
+		}
+		auto &positions = *representation.auxiliary_vec;
+		auto &exceptions = *representation.exception_vec;
+		for (idx_t i = 0; i < count; i++) {
+			auto row = uint64_t(row_ids[i]);
+			auto exception = LowerBound(positions, row);
+			if (exception < positions.size() &&
+			    SuccinctPrimitives::UnPackValue(positions.data(), exception, positions.width()) == row) {
+				dst[i] = T(SuccinctPrimitives::UnPackValue(exceptions.data(), exception, exceptions.width()) +
+				           representation.frame_of_reference);
+			}
+		}
+	}
+
+	//! Builds the DICTIONARY representation of 'count' strings: string_vec holds the distinct strings in sorted order,
+	//! auxiliary_vec their ends and the succinct vector the code of every row. The codes are ordered like the strings,
+	//! so comparisons with a constant are evaluated on the codes.
+	static void EncodeStrings(SegmentRepresentation &result, const string_t *values, idx_t count, bool pad_to_byte,
+	                          SuccinctEncoding max_encoding) {
+		auto less_than = [](const string_t &a, const string_t &b) { return LessThan::Operation(a, b); };
+		auto equals = [](const string_t &a, const string_t &b) { return Equals::Operation(a, b); };
+		vector<string_t> dictionary(values, values + count);
+		std::sort(dictionary.begin(), dictionary.end(), less_than);
+		dictionary.erase(std::unique(dictionary.begin(), dictionary.end(), equals), dictionary.end());
+
+		idx_t heap_size = 0;
+		for (auto &value : dictionary) {
+			heap_size += value.GetSize();
+		}
+		result.max_encoding = max_encoding;
+		result.padded = pad_to_byte;
+		result.encoding = SuccinctEncoding::DICTIONARY;
+		result.frame_of_reference = 0;
+		// a vector of bytes, which lie in memory one after another
+		result.string_vec = make_shared<sdsl::int_vector<>>(heap_size, 0, 8);
+		auto heap = (char *)result.string_vec->data();
+		vector<uint64_t> ends(dictionary.size());
+		idx_t heap_offset = 0;
+		for (idx_t i = 0; i < dictionary.size(); i++) {
+			memcpy(heap + heap_offset, dictionary[i].GetDataUnsafe(), dictionary[i].GetSize());
+			heap_offset += dictionary[i].GetSize();
+			ends[i] = heap_offset;
+		}
+		auto end_width = SuccinctPrimitives::MinimumBitWidth(heap_size, pad_to_byte);
+		result.auxiliary_vec = make_shared<sdsl::int_vector<>>(ends.size(), 0, end_width);
+		SuccinctPrimitives::PackBuffer<uint64_t>(result.auxiliary_vec->data(), ends.data(), ends.size(), end_width, 0);
+
+		vector<uint64_t> codes(count);
+		for (idx_t i = 0; i < count; i++) {
+			codes[i] = std::lower_bound(dictionary.begin(), dictionary.end(), values[i], less_than) - dictionary.begin();
+		}
+		auto code_width = SuccinctPrimitives::MinimumBitWidth(dictionary.empty() ? 0 : dictionary.size() - 1,
+		                                                      pad_to_byte);
+		result.succinct_vec = make_shared<sdsl::int_vector<>>(count, 0, code_width);
+		SuccinctPrimitives::PackBuffer<uint64_t>(result.succinct_vec->data(), codes.data(), count, code_width, 0);
+	}
+
+	//! The string of a code of a compacted VARCHAR representation. It points into string_vec.
+	static string_t DecodeString(const SegmentRepresentation &representation, uint64_t code) {
+		auto &ends = *representation.auxiliary_vec;
+		uint64_t begin = code == 0 ? 0 : SuccinctPrimitives::UnPackValue(ends.data(), code - 1, ends.width());
+		uint64_t end = SuccinctPrimitives::UnPackValue(ends.data(), code, ends.width());
+		return string_t((const char *)representation.string_vec->data() + begin, uint32_t(end - begin));
+	}
+
+	//! Decodes the strings of 'count' rows starting at row 'start' of a compacted VARCHAR representation into 'dst'
+	static void DecodeStrings(const SegmentRepresentation &representation, idx_t start, idx_t count,
+	                          string_t *__restrict dst) {
+		auto &codes = *representation.succinct_vec;
+		uint64_t batch[DECODE_BATCH_SIZE];
+		for (idx_t offset = 0; offset < count; offset += DECODE_BATCH_SIZE) {
+			idx_t batch_count = MinValue<idx_t>(DECODE_BATCH_SIZE, count - offset);
+			SuccinctPrimitives::UnPackBuffer<uint64_t>(batch, codes.data(), start + offset, batch_count,
+			                                           codes.width(), 0);
+			for (idx_t i = 0; i < batch_count; i++) {
+				dst[offset + i] = DecodeString(representation, batch[i]);
+			}
+		}
+	}
+
+	//! Returns the code of the first string of the dictionary of a compacted VARCHAR representation that is not
+	//! smaller than 'value'
+	static uint64_t LowerBoundString(const SegmentRepresentation &representation, const string_t &value) {
+		uint64_t lower = 0;
+		uint64_t upper = representation.auxiliary_vec->size();
+		while (lower < upper) {
+			uint64_t middle = lower + (upper - lower) / 2;
+			if (LessThan::Operation(DecodeString(representation, middle), value)) {
+				lower = middle + 1;
+			} else {
+				upper = middle;
+			}
+		}
+		return lower;
+	}
+
+private:
+	//! DELTA stores the value of every BLOCK_SIZE-th row
+	static constexpr const idx_t BLOCK_SIZE = SuccinctPrimitives::SUCCINCT_BLOCK_SIZE;
+	//! The largest exponent tried for storing floating point values as decimals
+	static constexpr const uint8_t MAX_DECIMAL_EXPONENT = 18;
+	//! Decimals are decoded in batches of this many values
+	static constexpr const idx_t DECODE_BATCH_SIZE = 1024;
+
+	static double PowerOfTen(uint8_t exponent) {
+		static const double POWERS_OF_TEN[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8, 1e9,
+		                                       1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+		return POWERS_OF_TEN[exponent];
+	}
+
+	//! Whether the value has the bits of the NaN NULLs are stored as. Other NaNs are not stored as decimals.
+	template <class T>
+	static bool IsNaNValue(T value) {
+		auto nan = NullValue<T>();
+		return memcmp(&value, &nan, sizeof(T)) == 0;
+	}
+
+	template <class T>
+	static T DecimalToValue(int64_t decimal, uint8_t exponent) {
+		return T(double(decimal) / PowerOfTen(exponent));
+	}
+
+	template <class T>
+	static bool TryConvertToDecimals(const T *values, idx_t count, uint8_t exponent, int64_t *decimals) {
+		// integers up to 2^53 convert to double exactly
+		static constexpr const double MAX_DECIMAL = 9007199254740992.0;
+		for (idx_t i = 0; i < count; i++) {
+			if (IsNaNValue<T>(values[i])) {
+				continue;
+			}
+			double scaled = std::nearbyint(double(values[i]) * PowerOfTen(exponent));
+			if (!(std::fabs(scaled) < MAX_DECIMAL)) {
+				return false;
+			}
+			decimals[i] = int64_t(scaled);
+			// compare the bits, so -0.0 (and NaNs with other bits) are not stored as decimals
+			auto converted = DecimalToValue<T>(decimals[i], exponent);
+			if (memcmp(&converted, &values[i], sizeof(T)) != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <class T>
+	static void DecodeValues(const SegmentRepresentation &representation, idx_t start, idx_t count,
+	                         T *__restrict dst, std::true_type is_floating_point) {
+		if (!representation.decimal_encoded) {
+			// the succinct vector holds the bits of the values
+			typedef typename std::conditional<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>::type BITS;
+			DecodeValues<BITS>(representation, start, count, (BITS *)dst, std::false_type());
+			return;
+		}
+		int64_t decimals[DECODE_BATCH_SIZE];
+		for (idx_t offset = 0; offset < count; offset += DECODE_BATCH_SIZE) {
+			idx_t batch_count = MinValue<idx_t>(DECODE_BATCH_SIZE, count - offset);
+			DecodeValues<int64_t>(representation, start + offset, batch_count, decimals, std::false_type());
+			for (idx_t i = 0; i < batch_count; i++) {
+				dst[offset + i] = decimals[i] == representation.nan_code
+				                      ? NullValue<T>()
+				                      : DecimalToValue<T>(decimals[i], representation.decimal_exponent);
+			}
+		}
+	}
+
+	template <class T>
+	static void DecodeValues(const SegmentRepresentation &representation, idx_t start, idx_t count,
+	                         T *__restrict dst, std::false_type is_floating_point) {
+		D_ASSERT(representation.succinct_vec);
+		auto &vec = *representation.succinct_vec;
+		auto frame_of_reference = representation.frame_of_reference;
+		switch (representation.encoding) {
+		case SuccinctEncoding::FRAME_OF_REFERENCE:
+			SuccinctPrimitives::UnPackBuffer<T>(dst, vec.data(), start, count, vec.width(), frame_of_reference);
+			break;
+		case SuccinctEncoding::PATCHED_FRAME_OF_REFERENCE: {
+			SuccinctPrimitives::UnPackBuffer<T>(dst, vec.data(), start, count, vec.width(), frame_of_reference);
+			// the packed vector only holds the low bits of the exceptions
+			auto &positions = *representation.auxiliary_vec;
+			auto &exceptions = *representation.exception_vec;
+			for (idx_t exception = LowerBound(positions, start); exception < positions.size(); exception++) {
+				auto row = SuccinctPrimitives::UnPackValue(positions.data(), exception, positions.width());
+				if (row >= start + count) {
+					break;
+				}
+				dst[row - start] =
+				    T(SuccinctPrimitives::UnPackValue(exceptions.data(), exception, exceptions.width()) +
+				      frame_of_reference);
+			}
+			break;
+		}
+		case SuccinctEncoding::DICTIONARY: {
+			auto &dictionary = *representation.auxiliary_vec;
+			for (idx_t i = 0; i < count; i++) {
+				auto code = SuccinctPrimitives::UnPackValue(vec.data(), start + i, vec.width());
+				dst[i] = T(SuccinctPrimitives::UnPackValue(dictionary.data(), code, dictionary.width()) +
+				           frame_of_reference);
+			}
+			break;
+		}
+		case SuccinctEncoding::RUN_LENGTH: {
+			auto &run_ends = *representation.auxiliary_vec;
+			idx_t i = 0;
+			for (idx_t run = FindRun(run_ends, start); i < count; run++) {
+				auto run_end = SuccinctPrimitives::UnPackValue(run_ends.data(), run, run_ends.width());
+				auto end = MinValue<idx_t>(run_end - start, count);
+				auto value = T(SuccinctPrimitives::UnPackValue(vec.data(), run, vec.width()) + frame_of_reference);
+				for (; i < end; i++) {
+					dst[i] = value;
+				}
+			}
+			break;
+		}
+		case SuccinctEncoding::DELTA: {
+			if (count == 0) {
+				break;
+			}
+			auto &blocks = *representation.auxiliary_vec;
+			auto delta_frame = representation.delta_frame_of_reference;
+			// start at the value stored for the block of the first row and add up the differences up to it
+			idx_t row = start - start % BLOCK_SIZE;
+			uint64_t value =
+			    SuccinctPrimitives::UnPackValue(blocks.data(), row / BLOCK_SIZE, blocks.width()) + frame_of_reference;
+			for (row++; row <= start; row++) {
+				value += SuccinctPrimitives::UnPackValue(vec.data(), row, vec.width()) + delta_frame;
+			}
+			dst[0] = T(value);
+			for (idx_t i = 1; i < count; i++) {
+				row = start + i;
+				if (row % BLOCK_SIZE == 0) {
+					value = SuccinctPrimitives::UnPackValue(blocks.data(), row / BLOCK_SIZE, blocks.width()) +
+					        frame_of_reference;
+				} else {
+					value += SuccinctPrimitives::UnPackValue(vec.data(), row, vec.width()) + delta_frame;
+				}
+				dst[i] = T(value);
+			}
+			break;
+		}
+		}
+	}
+
+	template <class T>
+	static succinct_width_t GetValueWidth(T minimum, T maximum, bool pad_to_byte) {
+		// the range is computed on the sign-extended values, which is exact for signed types as well
+		auto width = SuccinctPrimitives::MinimumBitWidth(uint64_t(maximum) - uint64_t(minimum), pad_to_byte);
+		return MinValue<succinct_width_t>(width, sizeof(T) * 8);
+	}
+
+	//! Returns the first entry of a sorted vector that is not smaller than 'value'
+	static idx_t LowerBound(const sdsl::int_vector<> &vec, uint64_t value) {
+		idx_t lower = 0;
+		idx_t upper = vec.size();
+		while (lower < upper) {
+			idx_t middle = lower + (upper - lower) / 2;
+			if (SuccinctPrimitives::UnPackValue(vec.data(), middle, vec.width()) < value) {
+				lower = middle + 1;
+			} else {
+				upper = middle;
+			}
+		}
+		return lower;
+	}
+
+	//! Returns the first run that ends after 'row'
+	static idx_t FindRun(const sdsl::int_vector<> &run_ends, idx_t row) {
+		return LowerBound(run_ends, row + 1);
+	}
+
+	template <class T>
+	static void EncodeFrameOfReference(SegmentRepresentation &result, const T *values, idx_t count, T minimum,
+	                                   succinct_width_t width) {
+		result.encoding = SuccinctEncoding::FRAME_OF_REFERENCE;
+		result.frame_of_reference = uint64_t(minimum);
+		result.succinct_vec = make_shared<sdsl::int_vector<>>(count, 0, width);
+		SuccinctPrimitives::PackBuffer<T>(result.succinct_vec->data(), values, count, width,
+		                                  result.frame_of_reference);
+	}
+
+	template <class T>
+	static void EncodePatchedFrameOfReference(SegmentRepresentation &result, const T *values, idx_t count, T minimum,
+	                                          succinct_width_t width, succinct_width_t exception_width,
+	                                          succinct_width_t position_width) {
+		D_ASSERT(width < 64);
+		result.encoding = SuccinctEncoding::PATCHED_FRAME_OF_REFERENCE;
+		result.frame_of_reference = uint64_t(minimum);
+		// the packing masks the exceptions to their low bits, which are overwritten when decoding them
+		result.succinct_vec = make_shared<sdsl::int_vector<>>(count, 0, width);
+		SuccinctPrimitives::PackBuffer<T>(result.succinct_vec->data(), values, count, width,
+		                                  result.frame_of_reference);
+
+		const uint64_t max_packed = (uint64_t(1) << width) - 1;
+		vector<uint64_t> positions;
+		vector<uint64_t> exceptions;
+		for (idx_t i = 0; i < count; i++) {
+			auto packed = uint64_t(values[i]) - result.frame_of_reference;
+			if (packed > max_packed) {
+				positions.push_back(i);
+				exceptions.push_back(packed);
+			}
+		}
+		result.auxiliary_vec = make_shared<sdsl::int_vector<>>(positions.size(), 0, position_width);
+		SuccinctPrimitives::PackBuffer<uint64_t>(result.auxiliary_vec->data(), positions.data(), positions.size(),
+		                                         position_width, 0);
+		result.exception_vec = make_shared<sdsl::int_vector<>>(exceptions.size(), 0, exception_width);
+		SuccinctPrimitives::PackBuffer<uint64_t>(result.exception_vec->data(), exceptions.data(), exceptions.size(),
+		                                         exception_width, 0);
+	}
+
+	template <class T>
+	static void EncodeDictionary(SegmentRepresentation &result, const T *values, idx_t count,
+	                             const vector<T> &dictionary, T value_min, succinct_width_t value_width,
+	                             bool pad_to_byte) {
+		result.encoding = SuccinctEncoding::DICTIONARY;
+		result.frame_of_reference = uint64_t(value_min);
+		result.auxiliary_vec = make_shared<sdsl::int_vector<>>(dictionary.size(), 0, value_width);
+		SuccinctPrimitives::PackBuffer<T>(result.auxiliary_vec->data(), dictionary.data(), dictionary.size(),
+		                                  value_width, result.frame_of_reference);
+
+		// the dictionary is sorted, so the codes are ordered like the values
+		vector<uint64_t> codes(count);
+		for (idx_t i = 0; i < count; i++) {
+			codes[i] = std::lower_bound(dictionary.begin(), dictionary.end(), values[i]) - dictionary.begin();
+		}
+		auto code_width = SuccinctPrimitives::MinimumBitWidth(dictionary.size() - 1, pad_to_byte);
+		result.succinct_vec = make_shared<sdsl::int_vector<>>(count, 0, code_width);
+		SuccinctPrimitives::PackBuffer<uint64_t>(result.succinct_vec->data(), codes.data(), count, code_width, 0);
+	}
+
+	template <class T>
+	static void EncodeRunLength(SegmentRepresentation &result, const T *values, idx_t count, idx_t run_count,
+	                            T value_min, succinct_width_t value_width, succinct_width_t run_end_width) {
+		vector<T> run_values;
+		vector<uint64_t> run_ends;
+		run_values.reserve(run_count);
+		run_ends.reserve(run_count);
+		for (idx_t i = 0; i < count; i++) {
+			if (i + 1 == count || values[i + 1] != values[i]) {
+				run_values.push_back(values[i]);
+				run_ends.push_back(i + 1);
+			}
+		}
+		D_ASSERT(run_values.size() == run_count);
+
+		result.encoding = SuccinctEncoding::RUN_LENGTH;
+		result.frame_of_reference = uint64_t(value_min);
+		result.succinct_vec = make_shared<sdsl::int_vector<>>(run_count, 0, value_width);
+		SuccinctPrimitives::PackBuffer<T>(result.succinct_vec->data(), run_values.data(), run_count, value_width,
+		                                  result.frame_of_reference);
+		result.auxiliary_vec = make_shared<sdsl::int_vector<>>(run_count, 0, run_end_width);
+		SuccinctPrimitives::PackBuffer<uint64_t>(result.auxiliary_vec->data(), run_ends.data(), run_count,
+		                                         run_end_width, 0);
+	}
+
+	template <class T>
+	static void EncodeDelta(SegmentRepresentation &result, const T *values, idx_t count, T value_min,
+	                        succinct_width_t value_width, uint64_t delta_min, succinct_width_t delta_width) {
+		// the difference stored for the first row of a block is never read
+		vector<uint64_t> deltas(count, delta_min);
+		for (idx_t i = 1; i < count; i++) {
+			deltas[i] = uint64_t(values[i]) - uint64_t(values[i - 1]);
+		}
+		idx_t block_count = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+		vector<T> block_values(block_count);
+		for (idx_t block = 0; block < block_count; block++) {
+			block_values[block] = values[block * BLOCK_SIZE];
+		}
+
+		result.encoding = SuccinctEncoding::DELTA;
+		result.frame_of_reference = uint64_t(value_min);
+		result.delta_frame_of_reference = delta_min;
+		result.succinct_vec = make_shared<sdsl::int_vector<>>(count, 0, delta_width);
+		SuccinctPrimitives::PackBuffer<uint64_t>(result.succinct_vec->data(), deltas.data(), count, delta_width,
+		                                         delta_min);
+		result.auxiliary_vec = make_shared<sdsl::int_vector<>>(block_count, 0, value_width);
+		SuccinctPrimitives::PackBuffer<T>(result.auxiliary_vec->data(), block_values.data(), block_count,
+		                                  value_width, result.frame_of_reference);
+	}
+};
+
+} // namespace duckdb
@@ -0,0 +1,71 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/storage/table/segment_spill_file.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/mutex.hpp"
+
+namespace duckdb {
+class DatabaseInstance;
+class SegmentSpillFile;
+
+//! The bytes of a spilled segment in the spill file. The region is freed when the last representation that refers to
+//! it is destroyed.
+struct SegmentSpillRegion {
+	SegmentSpillRegion(shared_ptr<SegmentSpillFile> file, idx_t offset, idx_t size, idx_t allocation_size)
+	    : file(move(file)), offset(offset), size(size), allocation_size(allocation_size) {
+	}
+	~SegmentSpillRegion();
+
+	shared_ptr<SegmentSpillFile> file;
+	idx_t offset;
+	//! The number of bytes written
+	idx_t size;
+	//! The number of bytes of the file reserved for the region
+	idx_t allocation_size;
+};
+
+//! A file in the temporary directory that holds the vectors of cold compacted segments, so that their memory can be
+//! freed. Space is handed out in multiples of SPILL_ALIGNMENT and reused once the regions are freed.
+class SegmentSpillFile : public std::enable_shared_from_this<SegmentSpillFile> {
+public:
+	static constexpr const idx_t SPILL_ALIGNMENT = 4096;
+
+public:
+	SegmentSpillFile(DatabaseInstance &db, string path);
+	~SegmentSpillFile();
+
+	//! Write 'size' bytes to a free region of the file
+	shared_ptr<SegmentSpillRegion> Write(const_data_ptr_t data, idx_t size);
+	//! Read the bytes of a region into 'target'
+	void Read(const SegmentSpillRegion &region, data_ptr_t target);
+
+	//! The size of the file, in bytes
+	idx_t GetFileSize();
+	//! The bytes of the file that are used by regions
+	idx_t GetUsedSize();
+
+private:
+	friend struct SegmentSpillRegion;
+	void Free(idx_t offset, idx_t size);
+
+private:
+	DatabaseInstance &db;
+	string path;
+	unique_ptr<FileHandle> handle;
+	mutex lock;
+	//! Free ranges of the file (offset -> size), adjacent ranges are merged
+	map<idx_t, idx_t> free_regions;
+	idx_t file_size;
+	idx_t used_size;
+};
+
+} // namespace duckdb
@@ -25,6 +25,7 @@ public:
 
 public:
 	bool CheckZonemap(ColumnScanState &state, TableFilter &filter) override;
+	bool CheckZonemapRange(ColumnScanState &state, idx_t end_row, TableFilter &filter) override;
 
 	void InitializeScan(ColumnScanState &state) override;
 	void InitializeScanWithOffset(ColumnScanState &state, idx_t row_idx) override;
@@ -32,6 +33,9 @@ public:
 	idx_t Scan(TransactionData transaction, idx_t vector_index, ColumnScanState &state, Vector &result) override;
 	idx_t ScanCommitted(idx_t vector_index, ColumnScanState &state, Vector &result, bool allow_updates) override;
 	idx_t ScanCount(ColumnScanState &state, Vector &result, idx_t count) override;
+	void Select(TransactionData transaction, idx_t vector_index, ColumnScanState &state, Vector &result,
+	            SelectionVector &sel, idx_t &count, const TableFilter &filter) override;
+	bool AggregateCompressed(ColumnScanState &state, idx_t count, SegmentAggregate &result) override;
 
 	void InitializeAppend(ColumnAppendState &state) override;
 	void AppendData(BaseStatistics &stats, ColumnAppendState &state, UnifiedVectorFormat &vdata, idx_t count) override;
@@ -39,6 +43,8 @@ public:
 	idx_t Fetch(ColumnScanState &state, row_t row_id, Vector &result) override;
 	void FetchRow(TransactionData transaction, ColumnFetchState &state, row_t row_id, Vector &result,
 	              idx_t result_idx) override;
+	void FetchRows(TransactionData transaction, ColumnFetchState &state, const row_t *row_ids, idx_t count,
+	               Vector &result, idx_t result_offset) override;
 	void Update(TransactionData transaction, idx_t column_index, Vector &update_vector, row_t *row_ids,
 	            idx_t update_count) override;
 	void UpdateColumn(TransactionData transaction, const vector<column_t> &column_path, Vector &update_vector,
@@ -61,6 +67,9 @@ public:
 	void Verify(RowGroup &parent) override;
 
 private:
+	//! Whether the zonemap of the segment (and of the updates) admits rows that pass the filter
+	bool CheckSegmentZonemap(ColumnSegment &segment, TableFilter &filter);
+
 	template <bool SCAN_COMMITTED, bool ALLOW_UPDATES>
 	void TemplatedScan(Transaction *transaction, ColumnScanState &state, Vector &result);
 };
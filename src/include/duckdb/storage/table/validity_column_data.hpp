@@ -21,6 +21,9 @@ public:
 
 public:
 	bool CheckZonemap(ColumnScanState &state, TableFilter &filter) override;
+	//! Whether any of the next 'count' rows of the scan can be NULL, decided on the statistics of the segment they lie
+	//! in. Does not move the scan forward.
+	bool CanHaveNull(ColumnScanState &state, idx_t count);
 };
 
 } // namespace duckdb
@@ -26,7 +26,6 @@ AttachedDatabase::AttachedDatabase(DatabaseInstance &db, Catalog &catalog_p, str
 	storage = make_unique<SingleFileStorageManager>(*this, move(file_path_p), access_mode == AccessMode::READ_ONLY);
 	catalog = make_unique<Catalog>(*this);
 	transaction_manager = make_unique<TransactionManager>(*this);
-	column_segment_catalog = make_unique<ColumnSegmentCatalog>();
 	internal = true;
 }
 
@@ -52,10 +51,6 @@ AttachedDatabase::~AttachedDatabase() {
 	}
 }
 
-ColumnSegmentCatalog& AttachedDatabase::GetColumnSegmentCatalog() {
-	return *column_segment_catalog.get();
-}
-
 bool AttachedDatabase::IsSystem() const {
 	D_ASSERT(!storage || type != AttachedDatabaseType::SYSTEM_DATABASE);
 	return type == AttachedDatabaseType::SYSTEM_DATABASE;
@@ -46,6 +46,18 @@ namespace duckdb {
 	{ nullptr, nullptr, LogicalTypeId::INVALID, nullptr, nullptr, nullptr, nullptr, nullptr }
 
 static ConfigurationOption internal_options[] = {DUCKDB_GLOBAL(AccessModeSetting),
+                                                 DUCKDB_GLOBAL(AdaptiveCompactionDecodeBudgetSetting),
+                                                 DUCKDB_GLOBAL(AdaptiveCompactionHeatDecaySetting),
+                                                 DUCKDB_GLOBAL(AdaptiveCompactionHysteresisRoundsSetting),
+                                                 DUCKDB_GLOBAL(AdaptiveCompactionIntervalSetting),
+                                                 DUCKDB_GLOBAL(AdaptiveCompactionPolicySetting),
+                                                 DUCKDB_GLOBAL(AdaptiveCompactionRatioSetting),
+                                                 DUCKDB_GLOBAL(AdaptiveCompactionScanWeightSetting),
+                                                 DUCKDB_GLOBAL(AdaptiveCompactionSpillEnabledSetting),
+                                                 DUCKDB_GLOBAL(AdaptiveCompactionTargetMemorySetting),
+                                                 DUCKDB_GLOBAL(AdaptiveCompactionThreadsSetting),
+                                                 DUCKDB_GLOBAL(AdaptiveSuccinctCompressionEnabledSetting),
+                                                 DUCKDB_GLOBAL(AggregatePushdownEnabledSetting),
                                                  DUCKDB_GLOBAL(CheckpointThresholdSetting),
                                                  DUCKDB_GLOBAL(DebugCheckpointAbort),
                                                  DUCKDB_LOCAL(DebugForceExternal),
@@ -77,6 +89,7 @@ static ConfigurationOption internal_options[] = {DUCKDB_GLOBAL(AccessModeSetting
                                                  DUCKDB_GLOBAL_ALIAS("memory_limit", MaximumMemorySetting),
                                                  DUCKDB_GLOBAL_ALIAS("null_order", DefaultNullOrderSetting),
                                                  DUCKDB_GLOBAL(PasswordSetting),
+                                                 DUCKDB_GLOBAL(PerfEventsEnabledSetting),
                                                  DUCKDB_LOCAL(PerfectHashThresholdSetting),
                                                  DUCKDB_LOCAL(PreserveIdentifierCase),
                                                  DUCKDB_GLOBAL(PreserveInsertionOrder),
@@ -87,6 +100,9 @@ static ConfigurationOption internal_options[] = {DUCKDB_GLOBAL(AccessModeSetting
                                                  DUCKDB_LOCAL(ProgressBarTimeSetting),
                                                  DUCKDB_LOCAL(SchemaSetting),
                                                  DUCKDB_LOCAL(SearchPathSetting),
+                                                 DUCKDB_GLOBAL(SuccinctEnabledSetting),
+                                                 DUCKDB_GLOBAL(SuccinctPaddedToNextByteEnabledSetting),
+                                                 DUCKDB_GLOBAL(SuccinctSharedFrameEnabledSetting),
                                                  DUCKDB_GLOBAL(TempDirectorySetting),
                                                  DUCKDB_GLOBAL(ThreadsSetting),
                                                  DUCKDB_GLOBAL(UsernameSetting),
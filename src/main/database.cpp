@@ -52,6 +52,10 @@ DatabaseInstance::DatabaseInstance() {
 }
 
 DatabaseInstance::~DatabaseInstance() {
+	// stop the background compaction before the scheduler and the segments it works on are destroyed
+	if (column_segment_catalog) {
+		column_segment_catalog->Shutdown();
+	}
 }
 
 BufferManager &BufferManager::GetBufferManager(DatabaseInstance &db) {
@@ -160,6 +164,7 @@ void DatabaseInstance::Initialize(const char *database_path, DBConfig *user_conf
 	}
 
 	auto &config = DBConfig::GetConfig(*this);
+	column_segment_catalog = make_unique<ColumnSegmentCatalog>(*this);
 	db_manager = make_unique<DatabaseManager>(*this);
 	buffer_manager =
 	    make_unique<BufferManager>(*this, config.options.temporary_directory, config.options.maximum_memory);
@@ -186,6 +191,9 @@ void DatabaseInstance::Initialize(const char *database_path, DBConfig *user_conf
 	// only increase thread count after storage init because we get races on catalog otherwise
 	scheduler->SetThreads(config.options.maximum_threads);
 
+	// starts the background thread if adaptive compaction is enabled
+	column_segment_catalog->Configure(config);
+
 	for (auto &open : config.replacement_opens) {
 		if (open.post_func && open.data) {
 			open.post_func(*this, open.data.get());
@@ -238,6 +246,10 @@ ConnectionManager &DatabaseInstance::GetConnectionManager() {
 	return *connection_manager;
 }
 
+ColumnSegmentCatalog &DatabaseInstance::GetColumnSegmentCatalog() {
+	return *column_segment_catalog;
+}
+
 FileSystem &DuckDB::GetFileSystem() {
 	return instance->GetFileSystem();
 }
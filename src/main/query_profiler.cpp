@@ -14,6 +14,7 @@
 #include "duckdb/main/client_config.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/client_data.hpp"
+#include "duckdb/main/config.hpp"
 #include <utility>
 #include <algorithm>
 
@@ -222,7 +223,8 @@ void QueryProfiler::Initialize(PhysicalOperator *root_op) {
 	}
 }
 
-OperatorProfiler::OperatorProfiler(bool enabled_p) : enabled(enabled_p), active_operator(nullptr) {
+OperatorProfiler::OperatorProfiler(bool enabled_p, bool perf_events_enabled_p)
+    : enabled(enabled_p), perf_events_enabled(enabled_p && perf_events_enabled_p), active_operator(nullptr) {
 }
 
 void OperatorProfiler::StartOperator(const PhysicalOperator *phys_op) {
@@ -238,6 +240,9 @@ void OperatorProfiler::StartOperator(const PhysicalOperator *phys_op) {
 
 	// start timing for current element
 	op.Start();
+	if (perf_events_enabled) {
+		op_perf_events = ThreadPerfEvents::Get().Read();
+	}
 }
 
 void OperatorProfiler::EndOperator(DataChunk *chunk) {
@@ -251,12 +256,17 @@ void OperatorProfiler::EndOperator(DataChunk *chunk) {
 
 	// finish timing for the current element
 	op.End();
+	PerfEventCounters perf_events;
+	if (perf_events_enabled) {
+		perf_events = ThreadPerfEvents::Get().Read() - op_perf_events;
+	}
 
-	AddTiming(active_operator, op.Elapsed(), chunk ? chunk->size() : 0);
+	AddTiming(active_operator, op.Elapsed(), chunk ? chunk->size() : 0, perf_events);
 	active_operator = nullptr;
 }
 
-void OperatorProfiler::AddTiming(const PhysicalOperator *op, double time, idx_t elements) {
+void OperatorProfiler::AddTiming(const PhysicalOperator *op, double time, idx_t elements,
+                                 const PerfEventCounters &perf_events) {
 	if (!enabled) {
 		return;
 	}
@@ -266,11 +276,14 @@ void OperatorProfiler::AddTiming(const PhysicalOperator *op, double time, idx_t
 	auto entry = timings.find(op);
 	if (entry == timings.end()) {
 		// add new entry
-		timings[op] = OperatorInformation(time, elements);
+		auto &info = timings[op];
+		info = OperatorInformation(time, elements);
+		info.perf_events = perf_events;
 	} else {
 		// add to existing entry
 		entry->second.time += time;
 		entry->second.elements += elements;
+		entry->second.perf_events += perf_events;
 	}
 }
 void OperatorProfiler::Flush(const PhysicalOperator *phys_op, ExpressionExecutor *expression_executor,
@@ -298,6 +311,7 @@ void QueryProfiler::Flush(OperatorProfiler &profiler) {
 
 		entry->second->info.time += node.second.time;
 		entry->second->info.elements += node.second.elements;
+		entry->second->info.perf_events += node.second.perf_events;
 		if (!IsDetailedEnabled()) {
 			continue;
 		}
@@ -514,11 +528,18 @@ static void ExtractFunctions(std::ostream &ss, ExpressionInfo &info, int &fun_id
 	}
 }
 
-static void ToJSONRecursive(QueryProfiler::TreeNode &node, std::ostream &ss, int depth = 1) {
+static void ToJSONRecursive(QueryProfiler::TreeNode &node, std::ostream &ss, bool perf_events, int depth = 1) {
 	ss << string(depth * 3, ' ') << " {\n";
 	ss << string(depth * 3, ' ') << "   \"name\": \"" + JSONSanitize(node.name) + "\",\n";
 	ss << string(depth * 3, ' ') << "   \"timing\":" + to_string(node.info.time) + ",\n";
 	ss << string(depth * 3, ' ') << "   \"cardinality\":" + to_string(node.info.elements) + ",\n";
+	if (perf_events) {
+		auto &counters = node.info.perf_events;
+		ss << string(depth * 3, ' ') << "   \"cycles\":" + to_string(counters.cycles) + ",\n";
+		ss << string(depth * 3, ' ') << "   \"instructions\":" + to_string(counters.instructions) + ",\n";
+		ss << string(depth * 3, ' ') << "   \"llc_misses\":" + to_string(counters.llc_misses) + ",\n";
+		ss << string(depth * 3, ' ') << "   \"branch_misses\":" + to_string(counters.branch_misses) + ",\n";
+	}
 	ss << string(depth * 3, ' ') << "   \"extra_info\": \"" + JSONSanitize(node.extra_info) + "\",\n";
 	ss << string(depth * 3, ' ') << "   \"timings\": [";
 	int32_t function_counter = 1;
@@ -550,7 +571,7 @@ static void ToJSONRecursive(QueryProfiler::TreeNode &node, std::ostream &ss, int
 			if (i > 0) {
 				ss << ",\n";
 			}
-			ToJSONRecursive(*node.children[i], ss, depth + 1);
+			ToJSONRecursive(*node.children[i], ss, perf_events, depth + 1);
 		}
 		ss << string(depth * 3, ' ') << "   ]\n";
 	}
@@ -592,7 +613,7 @@ string QueryProfiler::ToJSON() const {
 	ss << "   ],\n";
 	// recursively print the physical operator tree
 	ss << "   \"children\": [\n";
-	ToJSONRecursive(*root, ss);
+	ToJSONRecursive(*root, ss, DBConfig::GetConfig(context).perf_events_enabled);
 	ss << "   ]\n";
 	ss << "}";
 	return ss.str();
@@ -1,5 +1,6 @@
 #include "duckdb/main/settings.hpp"
 
+#include "duckdb/catalog/catalog.hpp"
 #include "duckdb/catalog/catalog_search_path.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/main/client_context.hpp"
@@ -52,6 +53,245 @@ Value AccessModeSetting::GetSetting(ClientContext &context) {
 	}
 }
 
+//===--------------------------------------------------------------------===//
+// Adaptive Compaction
+//===--------------------------------------------------------------------===//
+static void ConfigureAdaptiveCompaction(DatabaseInstance *db, DBConfig &config) {
+	if (db) {
+		db->GetColumnSegmentCatalog().Configure(config);
+	}
+}
+
+void AdaptiveCompactionDecodeBudgetSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto budget = input.GetValue<double>();
+	if (budget < 0 || budget > 1) {
+		throw InvalidInputException("adaptive_compaction_decode_budget must be between 0 and 1");
+	}
+	config.adaptive_compaction_decode_budget = budget;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+void AdaptiveCompactionDecodeBudgetSetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.adaptive_compaction_decode_budget = DBConfig().adaptive_compaction_decode_budget;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+Value AdaptiveCompactionDecodeBudgetSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::DOUBLE(config.adaptive_compaction_decode_budget);
+}
+
+void AdaptiveCompactionHeatDecaySetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto decay = input.GetValue<double>();
+	if (decay < 0 || decay >= 1) {
+		throw InvalidInputException("adaptive_compaction_heat_decay must be at least 0 and below 1");
+	}
+	config.adaptive_compaction_heat_decay = decay;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+void AdaptiveCompactionHeatDecaySetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.adaptive_compaction_heat_decay = DBConfig().adaptive_compaction_heat_decay;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+Value AdaptiveCompactionHeatDecaySetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::DOUBLE(config.adaptive_compaction_heat_decay);
+}
+
+void AdaptiveCompactionHysteresisRoundsSetting::SetGlobal(DatabaseInstance *db, DBConfig &config,
+                                                          const Value &input) {
+	auto rounds = input.GetValue<int64_t>();
+	if (rounds <= 0) {
+		throw InvalidInputException("adaptive_compaction_hysteresis_rounds must be at least 1");
+	}
+	config.adaptive_compaction_hysteresis_rounds = rounds;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+void AdaptiveCompactionHysteresisRoundsSetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.adaptive_compaction_hysteresis_rounds = DBConfig().adaptive_compaction_hysteresis_rounds;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+Value AdaptiveCompactionHysteresisRoundsSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BIGINT(config.adaptive_compaction_hysteresis_rounds);
+}
+
+void AdaptiveCompactionIntervalSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto interval = input.GetValue<int64_t>();
+	if (interval <= 0) {
+		throw InvalidInputException("adaptive_compaction_interval must be a positive number of milliseconds");
+	}
+	config.adaptive_compaction_interval = interval;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+void AdaptiveCompactionIntervalSetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.adaptive_compaction_interval = DBConfig().adaptive_compaction_interval;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+Value AdaptiveCompactionIntervalSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BIGINT(config.adaptive_compaction_interval);
+}
+
+void AdaptiveCompactionPolicySetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto parameter = StringUtil::Lower(input.ToString());
+	if (parameter == "fixed_ratio") {
+		config.adaptive_compaction_policy = AdaptiveCompactionPolicy::FIXED_RATIO;
+	} else if (parameter == "cost_model") {
+		config.adaptive_compaction_policy = AdaptiveCompactionPolicy::COST_MODEL;
+	} else {
+		throw InvalidInputException(
+		    "Unrecognized parameter for option ADAPTIVE_COMPACTION_POLICY \"%s\". Expected FIXED_RATIO or COST_MODEL.",
+		    parameter);
+	}
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+void AdaptiveCompactionPolicySetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.adaptive_compaction_policy = DBConfig().adaptive_compaction_policy;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+Value AdaptiveCompactionPolicySetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	switch (config.adaptive_compaction_policy) {
+	case AdaptiveCompactionPolicy::FIXED_RATIO:
+		return "fixed_ratio";
+	case AdaptiveCompactionPolicy::COST_MODEL:
+		return "cost_model";
+	default:
+		throw InternalException("Unknown adaptive compaction policy setting");
+	}
+}
+
+void AdaptiveCompactionRatioSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto ratio = input.GetValue<double>();
+	if (ratio < 0 || ratio > 1) {
+		throw InvalidInputException("adaptive_compaction_ratio must be between 0 and 1");
+	}
+	config.adaptive_compaction_ratio = ratio;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+void AdaptiveCompactionRatioSetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.adaptive_compaction_ratio = DBConfig().adaptive_compaction_ratio;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+Value AdaptiveCompactionRatioSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::DOUBLE(config.adaptive_compaction_ratio);
+}
+
+void AdaptiveCompactionScanWeightSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto weight = input.GetValue<double>();
+	if (weight < 0 || weight > 1) {
+		throw InvalidInputException("adaptive_compaction_scan_weight must be between 0 and 1");
+	}
+	config.adaptive_compaction_scan_weight = weight;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+void AdaptiveCompactionScanWeightSetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.adaptive_compaction_scan_weight = DBConfig().adaptive_compaction_scan_weight;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+Value AdaptiveCompactionScanWeightSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::DOUBLE(config.adaptive_compaction_scan_weight);
+}
+
+void AdaptiveCompactionSpillEnabledSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	config.adaptive_compaction_spill_enabled = input.GetValue<bool>();
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+void AdaptiveCompactionSpillEnabledSetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.adaptive_compaction_spill_enabled = DBConfig().adaptive_compaction_spill_enabled;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+Value AdaptiveCompactionSpillEnabledSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BOOLEAN(config.adaptive_compaction_spill_enabled);
+}
+
+void AdaptiveCompactionTargetMemorySetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	config.adaptive_compaction_target_memory = DBConfig::ParseMemoryLimit(input.ToString());
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+void AdaptiveCompactionTargetMemorySetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.adaptive_compaction_target_memory = DBConfig().adaptive_compaction_target_memory;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+Value AdaptiveCompactionTargetMemorySetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	if (config.adaptive_compaction_target_memory == (idx_t)-1) {
+		return Value();
+	}
+	return Value(StringUtil::BytesToHumanReadableString(config.adaptive_compaction_target_memory));
+}
+
+void AdaptiveCompactionThreadsSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto threads = input.GetValue<int64_t>();
+	if (threads <= 0) {
+		throw InvalidInputException("adaptive_compaction_threads must be at least 1");
+	}
+	config.adaptive_compaction_threads = threads;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+void AdaptiveCompactionThreadsSetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.adaptive_compaction_threads = DBConfig().adaptive_compaction_threads;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+Value AdaptiveCompactionThreadsSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BIGINT(config.adaptive_compaction_threads);
+}
+
+void AdaptiveSuccinctCompressionEnabledSetting::SetGlobal(DatabaseInstance *db, DBConfig &config,
+                                                          const Value &input) {
+	config.adaptive_succinct_compression_enabled = input.GetValue<bool>();
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+void AdaptiveSuccinctCompressionEnabledSetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.adaptive_succinct_compression_enabled = DBConfig().adaptive_succinct_compression_enabled;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+Value AdaptiveSuccinctCompressionEnabledSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BOOLEAN(config.adaptive_succinct_compression_enabled);
+}
+
+//===--------------------------------------------------------------------===//
+// Aggregate Pushdown Enabled
+//===--------------------------------------------------------------------===//
+void AggregatePushdownEnabledSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	config.aggregate_pushdown_enabled = input.GetValue<bool>();
+}
+
+void AggregatePushdownEnabledSetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.aggregate_pushdown_enabled = DBConfig().aggregate_pushdown_enabled;
+}
+
+Value AggregatePushdownEnabledSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BOOLEAN(config.aggregate_pushdown_enabled);
+}
+
 //===--------------------------------------------------------------------===//
 // Checkpoint Threshold
 //===--------------------------------------------------------------------===//
@@ -714,6 +954,24 @@ Value PasswordSetting::GetSetting(ClientContext &context) {
 	return Value();
 }
 
+//===--------------------------------------------------------------------===//
+// Perf Events Enabled
+//===--------------------------------------------------------------------===//
+void PerfEventsEnabledSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	config.perf_events_enabled = input.GetValue<bool>();
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+void PerfEventsEnabledSetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.perf_events_enabled = DBConfig().perf_events_enabled;
+	ConfigureAdaptiveCompaction(db, config);
+}
+
+Value PerfEventsEnabledSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BOOLEAN(config.perf_events_enabled);
+}
+
 //===--------------------------------------------------------------------===//
 // Perfect Hash Threshold
 //===--------------------------------------------------------------------===//
@@ -899,6 +1157,52 @@ Value SearchPathSetting::GetSetting(ClientContext &context) {
 	return Value(CatalogSearchEntry::ListToString(set_paths));
 }
 
+//===--------------------------------------------------------------------===//
+// Succinct
+//===--------------------------------------------------------------------===//
+// These apply to the segments created and the compactions started after the change
+void SuccinctEnabledSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	config.succinct_enabled = input.GetValue<bool>();
+}
+
+void SuccinctEnabledSetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.succinct_enabled = DBConfig().succinct_enabled;
+}
+
+Value SuccinctEnabledSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BOOLEAN(config.succinct_enabled);
+}
+
+void SuccinctPaddedToNextByteEnabledSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	config.succinct_padded_to_next_byte_enabled = input.GetValue<bool>();
+}
+
+void SuccinctPaddedToNextByteEnabledSetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.succinct_padded_to_next_byte_enabled = DBConfig().succinct_padded_to_next_byte_enabled;
+}
+
+Value SuccinctPaddedToNextByteEnabledSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BOOLEAN(config.succinct_padded_to_next_byte_enabled);
+}
+
+//===--------------------------------------------------------------------===//
+// Succinct Shared Frame Enabled
+//===--------------------------------------------------------------------===//
+void SuccinctSharedFrameEnabledSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	config.succinct_shared_frame_enabled = input.GetValue<bool>();
+}
+
+void SuccinctSharedFrameEnabledSetting::ResetGlobal(DatabaseInstance *db, DBConfig &config) {
+	config.succinct_shared_frame_enabled = DBConfig().succinct_shared_frame_enabled;
+}
+
+Value SuccinctSharedFrameEnabledSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BOOLEAN(config.succinct_shared_frame_enabled);
+}
+
 //===--------------------------------------------------------------------===//
 // Temp Directory
 //===--------------------------------------------------------------------===//
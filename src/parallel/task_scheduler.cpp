@@ -192,6 +192,15 @@ int32_t TaskScheduler::NumberOfThreads() {
 	return threads.size() + config.options.external_threads + 1;
 }
 
+idx_t TaskScheduler::NumberOfQueuedTasks() {
+#ifndef DUCKDB_NO_THREADS
+	return queue->q.size_approx();
+#else
+	lock_guard<mutex> lock(queue->qlock);
+	return queue->q.size();
+#endif
+}
+
 void TaskScheduler::SetThreads(int32_t n) {
 #ifndef DUCKDB_NO_THREADS
 	lock_guard<mutex> t(thread_lock);
@@ -1,10 +1,12 @@
 #include "duckdb/parallel/thread_context.hpp"
 #include "duckdb/execution/execution_context.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
 
 namespace duckdb {
 
-ThreadContext::ThreadContext(ClientContext &context) : profiler(QueryProfiler::Get(context).IsEnabled()) {
+ThreadContext::ThreadContext(ClientContext &context)
+    : profiler(QueryProfiler::Get(context).IsEnabled(), DBConfig::GetConfig(context).perf_events_enabled) {
 }
 
 } // namespace duckdb
@@ -1,5 +1,6 @@
 #include "duckdb/storage/buffer_manager.hpp"
 
+#include "duckdb/catalog/catalog_entry/column_segment_catalog.hpp"
 #include "duckdb/common/allocator.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/set.hpp"
@@ -7,6 +8,7 @@
 #include "duckdb/storage/in_memory_block_manager.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/main/attached_database.hpp"
+#include "duckdb/main/database.hpp"
 
 namespace duckdb {
 
@@ -471,6 +473,11 @@ BufferManager::EvictionResult BufferManager::EvictBlocks(idx_t extra_memory, idx
                                                          unique_ptr<FileBuffer> *buffer) {
 	BufferEvictionNode node;
 	TempBufferPoolReservation r(current_memory, extra_memory);
+	idx_t used_memory = current_memory;
+	if (used_memory > memory_limit) {
+		// compacting in-memory segments is cheaper than writing blocks to the temporary directory (or failing)
+		db.GetColumnSegmentCatalog().ReclaimMemory(used_memory - memory_limit);
+	}
 	while (current_memory > memory_limit) {
 		// get a block to unpin from the queue
 		if (!queue->q.try_dequeue(node)) {
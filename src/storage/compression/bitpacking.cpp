@@ -716,6 +716,38 @@ public:
 	}
 };
 
+//! The position of a bitpacking scan in its segment. Saved and restored around operations that read ahead of the scan
+//! without moving it.
+template <class T>
+struct BitpackingScanPosition {
+	explicit BitpackingScanPosition(const BitpackingScanState<T> &state)
+	    : current_group(state.current_group), current_width(state.current_width),
+	      current_frame_of_reference(state.current_frame_of_reference), current_constant(state.current_constant),
+	      current_delta_offset(state.current_delta_offset), current_group_offset(state.current_group_offset),
+	      current_group_ptr(state.current_group_ptr), bitpacking_metadata_ptr(state.bitpacking_metadata_ptr) {
+	}
+
+	bitpacking_metadata_t current_group;
+	bitpacking_width_t current_width;
+	T current_frame_of_reference;
+	T current_constant;
+	T current_delta_offset;
+	idx_t current_group_offset;
+	data_ptr_t current_group_ptr;
+	data_ptr_t bitpacking_metadata_ptr;
+
+	void Restore(BitpackingScanState<T> &state) const {
+		state.current_group = current_group;
+		state.current_width = current_width;
+		state.current_frame_of_reference = current_frame_of_reference;
+		state.current_constant = current_constant;
+		state.current_delta_offset = current_delta_offset;
+		state.current_group_offset = current_group_offset;
+		state.current_group_ptr = current_group_ptr;
+		state.bitpacking_metadata_ptr = bitpacking_metadata_ptr;
+	}
+};
+
 template <class T>
 unique_ptr<SegmentScanState> BitpackingInitScan(ColumnSegment &segment) {
 	auto result = make_unique<BitpackingScanState<T>>(segment);
@@ -867,6 +899,91 @@ void BitpackingSkip(ColumnSegment &segment, ColumnScanState &state, idx_t skip_c
 	scan_state.Skip(segment, skip_count);
 }
 
+//===--------------------------------------------------------------------===//
+// Aggregate
+//===--------------------------------------------------------------------===//
+template <class T, class T_S = typename std::make_signed<T>::type>
+bool BitpackingAggregate(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count,
+                         SegmentAggregate &result) {
+	// the groups are read from the position of the scan (which is at the current row), which is restored afterwards:
+	// the block stays pinned by the scan and DELTA_FOR groups are not decoded up to the current row again
+	auto &scan_state = (BitpackingScanState<T> &)*state.scan_state;
+	BitpackingScanPosition<T> position(scan_state);
+
+	//! Because FOR offsets all our values to be 0 or above, we can always skip sign extension here
+	bool skip_sign_extend = true;
+
+	idx_t aggregated = 0;
+	while (aggregated < scan_count) {
+		if (scan_state.current_group_offset >= BITPACKING_METADATA_GROUP_SIZE) {
+			scan_state.LoadNextGroup();
+		}
+
+		if (scan_state.current_group.mode == BitpackingMode::CONSTANT) {
+			idx_t to_scan =
+			    MinValue(scan_count - aggregated, BITPACKING_METADATA_GROUP_SIZE - scan_state.current_group_offset);
+			result.Add(Hugeint::Convert(scan_state.current_constant), to_scan);
+			aggregated += to_scan;
+			scan_state.current_group_offset += to_scan;
+			continue;
+		}
+		if (scan_state.current_group.mode == BitpackingMode::CONSTANT_DELTA) {
+			idx_t to_scan =
+			    MinValue(scan_count - aggregated, BITPACKING_METADATA_GROUP_SIZE - scan_state.current_group_offset);
+			// the values are an arithmetic sequence: its sum and bounds follow from the first and the last value
+			T first = (scan_state.current_group_offset * scan_state.current_constant) +
+			          scan_state.current_frame_of_reference;
+			T last = ((scan_state.current_group_offset + to_scan - 1) * scan_state.current_constant) +
+			         scan_state.current_frame_of_reference;
+			auto first_value = Hugeint::Convert(first);
+			auto last_value = Hugeint::Convert(last);
+			result.count += to_scan;
+			if (result.needs_sum) {
+				result.sum += (first_value + last_value) * hugeint_t(int64_t(to_scan)) / hugeint_t(2);
+			}
+			if (result.needs_min_max) {
+				auto low = first_value < last_value ? first_value : last_value;
+				auto high = first_value < last_value ? last_value : first_value;
+				result.min = low < result.min ? low : result.min;
+				result.max = high > result.max ? high : result.max;
+			}
+			aggregated += to_scan;
+			scan_state.current_group_offset += to_scan;
+			continue;
+		}
+		D_ASSERT(scan_state.current_group.mode == BitpackingMode::FOR ||
+		         scan_state.current_group.mode == BitpackingMode::DELTA_FOR);
+
+		// FOR and DELTA_FOR are decoded one compression algorithm group at a time
+		idx_t offset_in_compression_group =
+		    scan_state.current_group_offset % BitpackingPrimitives::BITPACKING_ALGORITHM_GROUP_SIZE;
+		idx_t remaining_in_compression_group =
+		    BitpackingPrimitives::BITPACKING_ALGORITHM_GROUP_SIZE - offset_in_compression_group;
+		idx_t to_scan = MinValue<idx_t>(scan_count - aggregated, remaining_in_compression_group);
+		data_ptr_t decompression_group_start_pointer =
+		    scan_state.current_group_ptr +
+		    (scan_state.current_group_offset - offset_in_compression_group) * scan_state.current_width / 8;
+		BitpackingPrimitives::UnPackBlock<T>((data_ptr_t)scan_state.decompression_buffer,
+		                                     decompression_group_start_pointer, scan_state.current_width,
+		                                     skip_sign_extend);
+
+		T *values = scan_state.decompression_buffer + offset_in_compression_group;
+		if (scan_state.current_group.mode == BitpackingMode::DELTA_FOR) {
+			ApplyFrameOfReference<T_S>((T_S *)values, (T_S)scan_state.current_frame_of_reference, to_scan);
+			DeltaDecode<T_S>((T_S *)values, (T_S)scan_state.current_delta_offset, to_scan);
+			scan_state.current_delta_offset = values[to_scan - 1];
+		} else {
+			ApplyFrameOfReference<T>(values, scan_state.current_frame_of_reference, to_scan);
+		}
+		result.AddValues<T>(values, to_scan);
+
+		aggregated += to_scan;
+		scan_state.current_group_offset += to_scan;
+	}
+	position.Restore(scan_state);
+	return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Get Function
 //===--------------------------------------------------------------------===//
@@ -875,7 +992,9 @@ CompressionFunction GetBitpackingFunction(PhysicalType data_type) {
 	return CompressionFunction(CompressionType::COMPRESSION_BITPACKING, data_type, BitpackingInitAnalyze<T>,
 	                           BitpackingAnalyze<T>, BitpackingFinalAnalyze<T>, BitpackingInitCompression<T>,
 	                           BitpackingCompress<T>, BitpackingFinalizeCompress<T>, BitpackingInitScan<T>,
-	                           BitpackingScan<T>, BitpackingScanPartial<T>, BitpackingFetchRow<T>, BitpackingSkip<T>);
+	                           BitpackingScan<T>, BitpackingScanPartial<T>, BitpackingFetchRow<T>, BitpackingSkip<T>,
+	                           nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+	                           BitpackingAggregate<T>);
 }
 
 CompressionFunction BitpackingFun::GetFunction(PhysicalType type) {
@@ -186,6 +186,19 @@ void FixedSizeFetchRow(ColumnSegment &segment, ColumnFetchState &state, row_t ro
 	memcpy(FlatVector::GetData(result) + result_idx * sizeof(T), data_ptr, sizeof(T));
 }
 
+template <class T>
+void FixedSizeFetchRows(ColumnSegment &segment, ColumnFetchState &state, const row_t *row_ids, idx_t count,
+                        Vector &result, idx_t result_offset) {
+	auto &buffer_manager = BufferManager::GetBufferManager(segment.db);
+	auto handle = buffer_manager.Pin(segment.block);
+
+	auto source_data = handle.Ptr() + segment.GetBlockOffset();
+	auto result_data = FlatVector::GetData(result) + result_offset * sizeof(T);
+	for (idx_t i = 0; i < count; i++) {
+		memcpy(result_data + i * sizeof(T), source_data + row_ids[i] * sizeof(T), sizeof(T));
+	}
+}
+
 //===--------------------------------------------------------------------===//
 // Append
 //===--------------------------------------------------------------------===//
@@ -265,7 +278,7 @@ CompressionFunction FixedSizeGetFunction(PhysicalType data_type) {
 	                           UncompressedFunctions::Compress, UncompressedFunctions::FinalizeCompress,
 	                           FixedSizeInitScan, FixedSizeScan<T>, FixedSizeScanPartial<T>, FixedSizeFetchRow<T>,
 	                           UncompressedFunctions::EmptySkip, nullptr, FixedSizeInitAppend, FixedSizeAppend<T>,
-	                           FixedSizeFinalizeAppend<T>, nullptr);
+	                           FixedSizeFinalizeAppend<T>, nullptr, nullptr, FixedSizeFetchRows<T>);
 }
 
 CompressionFunction FixedSizeUncompressed::GetFunction(PhysicalType data_type) {
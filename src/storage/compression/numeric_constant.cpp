@@ -1,6 +1,7 @@
 #include "duckdb/function/compression/compression.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
 #include "duckdb/common/types/vector.hpp"
+#include "duckdb/common/types/hugeint.hpp"
 #include "duckdb/storage/statistics/numeric_statistics.hpp"
 #include "duckdb/storage/statistics/validity_statistics.hpp"
 #include "duckdb/storage/table/column_segment.hpp"
@@ -89,6 +90,26 @@ void ConstantFetchRow(ColumnSegment &segment, ColumnFetchState &state, row_t row
 	ConstantFillFunction<T>(segment, result, result_idx, 1);
 }
 
+//===--------------------------------------------------------------------===//
+// Aggregate
+//===--------------------------------------------------------------------===//
+template <class T>
+bool ConstantAggregate(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, SegmentAggregate &result) {
+	auto &nstats = (NumericStatistics &)*segment.stats.statistics;
+	result.Add(Hugeint::Convert(nstats.min.GetValueUnsafe<T>()), scan_count);
+	return true;
+}
+
+template <class T>
+static compression_aggregate_t ConstantGetAggregate(std::true_type is_integral) {
+	return ConstantAggregate<T>;
+}
+
+template <class T>
+static compression_aggregate_t ConstantGetAggregate(std::false_type is_integral) {
+	return nullptr;
+}
+
 //===--------------------------------------------------------------------===//
 // Get Function
 //===--------------------------------------------------------------------===//
@@ -103,7 +124,8 @@ template <class T>
 CompressionFunction ConstantGetFunction(PhysicalType data_type) {
 	return CompressionFunction(CompressionType::COMPRESSION_CONSTANT, data_type, nullptr, nullptr, nullptr, nullptr,
 	                           nullptr, nullptr, ConstantInitScan, ConstantScanFunction<T>, ConstantScanPartial<T>,
-	                           ConstantFetchRow<T>, UncompressedFunctions::EmptySkip);
+	                           ConstantFetchRow<T>, UncompressedFunctions::EmptySkip, nullptr, nullptr, nullptr,
+	                           nullptr, nullptr, nullptr, nullptr, ConstantGetAggregate<T>(std::is_integral<T>()));
 }
 
 CompressionFunction ConstantFun::GetFunction(PhysicalType data_type) {
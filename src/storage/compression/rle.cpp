@@ -6,6 +6,7 @@
 #include "duckdb/storage/table/column_data_checkpointer.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
 #include "duckdb/common/types/null_value.hpp"
+#include "duckdb/common/types/hugeint.hpp"
 #include <functional>
 
 namespace duckdb {
@@ -338,6 +339,41 @@ void RLEFetchRow(ColumnSegment &segment, ColumnFetchState &state, row_t row_id,
 	result_data[result_idx] = data_pointer[scan_state.entry_pos];
 }
 
+//===--------------------------------------------------------------------===//
+// Aggregate
+//===--------------------------------------------------------------------===//
+template <class T>
+bool RLEAggregate(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, SegmentAggregate &result) {
+	auto &scan_state = (RLEScanState<T> &)*state.scan_state;
+
+	auto data = scan_state.handle.Ptr() + segment.GetBlockOffset();
+	auto data_pointer = (T *)(data + RLEConstants::RLE_HEADER_SIZE);
+	auto index_pointer = (rle_count_t *)(data + scan_state.rle_count_offset);
+
+	// every run is added at once, the scan state itself is not moved
+	idx_t entry_pos = scan_state.entry_pos;
+	idx_t position_in_entry = scan_state.position_in_entry;
+	idx_t remaining = scan_count;
+	while (remaining > 0) {
+		auto run_count = MinValue<idx_t>(remaining, index_pointer[entry_pos] - position_in_entry);
+		result.Add(Hugeint::Convert(data_pointer[entry_pos]), run_count);
+		remaining -= run_count;
+		entry_pos++;
+		position_in_entry = 0;
+	}
+	return true;
+}
+
+template <class T>
+static compression_aggregate_t RLEGetAggregate(std::true_type is_integral) {
+	return RLEAggregate<T>;
+}
+
+template <class T>
+static compression_aggregate_t RLEGetAggregate(std::false_type is_integral) {
+	return nullptr;
+}
+
 //===--------------------------------------------------------------------===//
 // Get Function
 //===--------------------------------------------------------------------===//
@@ -345,7 +381,9 @@ template <class T>
 CompressionFunction GetRLEFunction(PhysicalType data_type) {
 	return CompressionFunction(CompressionType::COMPRESSION_RLE, data_type, RLEInitAnalyze<T>, RLEAnalyze<T>,
 	                           RLEFinalAnalyze<T>, RLEInitCompression<T>, RLECompress<T>, RLEFinalizeCompress<T>,
-	                           RLEInitScan<T>, RLEScan<T>, RLEScanPartial<T>, RLEFetchRow<T>, RLESkip<T>);
+	                           RLEInitScan<T>, RLEScan<T>, RLEScanPartial<T>, RLEFetchRow<T>, RLESkip<T>, nullptr,
+	                           nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+	                           RLEGetAggregate<T>(std::is_integral<T>()));
 }
 
 CompressionFunction RLEFun::GetFunction(PhysicalType type) {
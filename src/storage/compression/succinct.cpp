@@ -1,13 +1,18 @@
 #include "duckdb/function/compression/compression.hpp"
+#include "duckdb/common/operator/comparison_operators.hpp"
+#include "duckdb/common/succinct_primitives.hpp"
+#include "duckdb/common/types/hugeint.hpp"
 #include "duckdb/common/types/null_value.hpp"
 #include "duckdb/common/types/vector.hpp"
 #include "duckdb/function/compression_function.hpp"
 #include "duckdb/main/config.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
-#include "duckdb/storage/checkpoint/write_overflow_strings_to_disk.hpp"
 #include "duckdb/storage/segment/uncompressed.hpp"
 #include "duckdb/storage/statistics/numeric_statistics.hpp"
 #include "duckdb/storage/table/append_state.hpp"
+#include "duckdb/storage/table/column_data.hpp"
 #include "duckdb/storage/table/column_data_checkpointer.hpp"
 #include "duckdb/storage/table/column_segment.hpp"
 #include <sdsl/vectors.hpp>
@@ -15,264 +20,647 @@
 
 namespace duckdb {
 
+//===--------------------------------------------------------------------===//
+// Storage Format
+//===--------------------------------------------------------------------===//
+// A succinct segment on disk (or in any other block) consists of a header holding the frame of reference (the min
+// factor, stored as uint64_t) and the bit width, followed by the packed words in the layout of sdsl::int_vector<>.
+// The number of values is stored in the data pointer of the segment.
+static constexpr const idx_t SUCCINCT_HEADER_SIZE = 2 * sizeof(uint64_t);
+
+struct SuccinctHeader {
+	uint64_t frame_of_reference;
+	succinct_width_t width;
+	const uint64_t *packed;
+
+	static SuccinctHeader Read(const_data_ptr_t base_ptr) {
+		SuccinctHeader header;
+		header.frame_of_reference = Load<uint64_t>(base_ptr);
+		header.width = (succinct_width_t)Load<uint64_t>(base_ptr + sizeof(uint64_t));
+		header.packed = (const uint64_t *)(base_ptr + SUCCINCT_HEADER_SIZE);
+		return header;
+	}
+
+	static void Write(data_ptr_t base_ptr, uint64_t frame_of_reference, succinct_width_t width) {
+		Store<uint64_t>(frame_of_reference, base_ptr);
+		Store<uint64_t>(width, base_ptr + sizeof(uint64_t));
+	}
+
+	//! The header of the in-memory succinct vector of a compactable segment
+	static SuccinctHeader Get(const SegmentRepresentation &representation) {
+		D_ASSERT(representation.succinct_vec);
+		SuccinctHeader header;
+		header.frame_of_reference = representation.frame_of_reference;
+		header.width = representation.succinct_vec->width();
+		header.packed = representation.succinct_vec->data();
+		return header;
+	}
+};
+
+//! The segment that is currently being analyzed or written. Every segment gets its own frame of reference and is
+//! filled until the packed values no longer fit into a block. NULLs do not affect the frame of reference or width.
+template <class T>
+struct SuccinctSegmentState {
+	explicit SuccinctSegmentState(bool pad_to_byte) : pad_to_byte(pad_to_byte) {
+		Reset();
+	}
+
+	bool pad_to_byte;
+	idx_t count;
+	bool all_invalid;
+	T minimum;
+	T maximum;
+	succinct_width_t width;
+
+	void Reset() {
+		count = 0;
+		all_invalid = true;
+		minimum = T(0);
+		maximum = T(0);
+		width = 1;
+	}
+
+	uint64_t GetFrameOfReference() const {
+		return all_invalid ? 0 : uint64_t(minimum);
+	}
+
+	//! The size of the segment in bytes
+	idx_t GetSize() const {
+		return SUCCINCT_HEADER_SIZE + SuccinctPrimitives::GetPackedSize(count, width);
+	}
+
+	//! Add a value to the segment, returns false (without adding it) if the segment is full
+	bool TryAdd(T value, bool is_valid) {
+		T new_minimum = minimum;
+		T new_maximum = maximum;
+		succinct_width_t new_width = width;
+		if (is_valid && (all_invalid || value < minimum || value > maximum)) {
+			new_minimum = all_invalid ? value : MinValue<T>(minimum, value);
+			new_maximum = all_invalid ? value : MaxValue<T>(maximum, value);
+			// the range is computed on the (sign-extended) unsigned representation, so it fits for signed types too
+			new_width =
+			    SuccinctPrimitives::MinimumBitWidth(uint64_t(new_maximum) - uint64_t(new_minimum), pad_to_byte);
+		}
+		if (SUCCINCT_HEADER_SIZE + SuccinctPrimitives::GetPackedSize(count + 1, new_width) > Storage::BLOCK_SIZE) {
+			return false;
+		}
+		minimum = new_minimum;
+		maximum = new_maximum;
+		width = new_width;
+		all_invalid = all_invalid && !is_valid;
+		count++;
+		return true;
+	}
+};
+
 //===--------------------------------------------------------------------===//
 // Analyze
 //===--------------------------------------------------------------------===//
+template <class T>
 struct SuccinctAnalyzeState : public AnalyzeState {
-	SuccinctAnalyzeState() : count(0) {
+	SuccinctAnalyzeState(bool enabled, bool pad_to_byte) : enabled(enabled), segment(pad_to_byte), total_size(0) {
 	}
 
-	idx_t count;
+	bool enabled;
+	SuccinctSegmentState<T> segment;
+	//! The size of all completed segments
+	idx_t total_size;
 };
 
+template <class T>
 unique_ptr<AnalyzeState> SuccinctInitAnalyze(ColumnData &col_data, PhysicalType type) {
-	return make_unique<SuccinctAnalyzeState>();
+	auto &config = DBConfig::GetConfig(col_data.GetDatabase());
+	return make_unique<SuccinctAnalyzeState<T>>(config.succinct_enabled, config.succinct_padded_to_next_byte_enabled);
 }
 
+template <class T>
 bool SuccinctAnalyze(AnalyzeState &state_p, Vector &input, idx_t count) {
-	auto &state = (SuccinctAnalyzeState &)state_p;
-	state.count += count;
+	auto &state = (SuccinctAnalyzeState<T> &)state_p;
+	if (!state.enabled || std::is_floating_point<T>::value) {
+		// floating point values are only compacted in memory, the storage format holds integers
+		return false;
+	}
+	UnifiedVectorFormat vdata;
+	input.ToUnifiedFormat(count, vdata);
+	auto data = (T *)vdata.data;
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = vdata.sel->get_index(i);
+		bool is_valid = vdata.validity.RowIsValid(idx);
+		if (!state.segment.TryAdd(data[idx], is_valid)) {
+			state.total_size += state.segment.GetSize();
+			state.segment.Reset();
+			state.segment.TryAdd(data[idx], is_valid);
+		}
+	}
 	return true;
 }
 
 template <class T>
 idx_t SuccinctFinalAnalyze(AnalyzeState &state_p) {
-	auto &state = (SuccinctAnalyzeState &)state_p;
-	return sizeof(T) * state.count;
+	auto &state = (SuccinctAnalyzeState<T> &)state_p;
+	if (std::is_floating_point<T>::value) {
+		return DConstants::INVALID_INDEX;
+	}
+	return state.total_size + state.segment.GetSize();
 }
 
 //===--------------------------------------------------------------------===//
 // Compress
 //===--------------------------------------------------------------------===//
+template <class T>
 struct SuccinctCompressState : public CompressionState {
-	explicit SuccinctCompressState(ColumnDataCheckpointer &checkpointer);
+	explicit SuccinctCompressState(ColumnDataCheckpointer &checkpointer)
+	    : checkpointer(checkpointer),
+	      segment(DBConfig::GetConfig(checkpointer.GetDatabase()).succinct_padded_to_next_byte_enabled),
+	      row_start(checkpointer.GetRowGroup().start) {
+		auto &config = DBConfig::GetConfig(checkpointer.GetDatabase());
+		function = config.GetCompressionFunction(CompressionType::COMPRESSION_SUCCINCT,
+		                                         checkpointer.GetType().InternalType());
+	}
 
 	ColumnDataCheckpointer &checkpointer;
-	unique_ptr<ColumnSegment> current_segment;
-	ColumnAppendState append_state;
+	CompressionFunction *function;
+	SuccinctSegmentState<T> segment;
+	//! The values of the current segment
+	vector<T> values;
+	//! The first row of the current segment
+	idx_t row_start;
+
+public:
+	void Append(UnifiedVectorFormat &vdata, idx_t count) {
+		auto data = (T *)vdata.data;
+		for (idx_t i = 0; i < count; i++) {
+			auto idx = vdata.sel->get_index(i);
+			bool is_valid = vdata.validity.RowIsValid(idx);
+			if (!segment.TryAdd(data[idx], is_valid)) {
+				FlushSegment();
+				segment.TryAdd(data[idx], is_valid);
+			}
+			// NULLs keep whatever value is in the vector: the packing masks them to the width of the segment
+			values.push_back(data[idx]);
+		}
+	}
 
-	virtual void CreateEmptySegment(idx_t row_start);
-	void FlushSegment(idx_t segment_size);
-	void Finalize(idx_t segment_size);
-};
+	void FlushSegment() {
+		if (segment.count == 0) {
+			return;
+		}
+		auto &db = checkpointer.GetDatabase();
+		auto &type = checkpointer.GetType();
+		auto compressed_segment = ColumnSegment::CreateTransientSegment(db, type, row_start);
+		compressed_segment->function = function;
+
+		auto &buffer_manager = BufferManager::GetBufferManager(db);
+		auto handle = buffer_manager.Pin(compressed_segment->block);
+		auto base_ptr = handle.Ptr();
+		auto frame_of_reference = segment.GetFrameOfReference();
+		SuccinctHeader::Write(base_ptr, frame_of_reference, segment.width);
+		auto packed_ptr = (uint64_t *)(base_ptr + SUCCINCT_HEADER_SIZE);
+		memset(packed_ptr, 0, SuccinctPrimitives::GetPackedSize(segment.count, segment.width));
+		SuccinctPrimitives::PackBuffer<T>(packed_ptr, values.data(), segment.count, segment.width,
+		                                  frame_of_reference);
+		handle.Destroy();
+
+		compressed_segment->count = segment.count;
+		if (!segment.all_invalid) {
+			NumericStatistics::Update<T>(compressed_segment->stats, segment.minimum);
+			NumericStatistics::Update<T>(compressed_segment->stats, segment.maximum);
+		}
 
-SuccinctCompressState::SuccinctCompressState(ColumnDataCheckpointer &checkpointer)
-    : checkpointer(checkpointer) {
-	CreateEmptySegment(checkpointer.GetRowGroup().start);
-}
+		auto segment_size = segment.GetSize();
+		row_start += segment.count;
+		values.clear();
+		segment.Reset();
+		checkpointer.GetCheckpointState().FlushSegment(move(compressed_segment), segment_size);
+	}
 
-void SuccinctCompressState::CreateEmptySegment(idx_t row_start) {
-	auto &db = checkpointer.GetDatabase();
-	auto &type = checkpointer.GetType();
-	auto compressed_segment = ColumnSegment::CreateTransientSegment(db, type, row_start);
-	if (type.InternalType() == PhysicalType::VARCHAR) {
-		auto &state = (UncompressedStringSegmentState &)*compressed_segment->GetSegmentState();
-		state.overflow_writer = make_unique<WriteOverflowStringsToDisk>(checkpointer.GetColumnData().block_manager);
+	void Finalize() {
+		FlushSegment();
 	}
-	current_segment = move(compressed_segment);
-	current_segment->InitializeAppend(append_state);
-}
+};
 
-void SuccinctCompressState::FlushSegment(idx_t segment_size) {
-	auto &state = checkpointer.GetCheckpointState();
-	state.FlushSegment(move(current_segment), segment_size);
+template <class T>
+unique_ptr<CompressionState> SuccinctInitCompression(ColumnDataCheckpointer &checkpointer,
+                                                     unique_ptr<AnalyzeState> state) {
+	return make_unique<SuccinctCompressState<T>>(checkpointer);
 }
 
-void SuccinctCompressState::Finalize(idx_t segment_size) {
-	FlushSegment(segment_size);
-	current_segment.reset();
+template <class T>
+void SuccinctCompress(CompressionState &state_p, Vector &scan_vector, idx_t count) {
+	auto &state = (SuccinctCompressState<T> &)state_p;
+	UnifiedVectorFormat vdata;
+	scan_vector.ToUnifiedFormat(count, vdata);
+	state.Append(vdata, count);
 }
 
-unique_ptr<CompressionState> InitCompression(ColumnDataCheckpointer &checkpointer,
-                                                                    unique_ptr<AnalyzeState> state) {
-	return make_unique<SuccinctCompressState>(checkpointer);
+template <class T>
+void SuccinctFinalizeCompress(CompressionState &state_p) {
+	auto &state = (SuccinctCompressState<T> &)state_p;
+	state.Finalize();
 }
 
-void Compress(CompressionState &state_p, Vector &data, idx_t count) {
-	std::cout << "[Succinct Compress] SHOULD NOT HAPPEN" << std::endl;
-
-	auto &state = (SuccinctCompressState &)state_p;
-	UnifiedVectorFormat vdata;
-	data.ToUnifiedFormat(count, vdata);
-
-	idx_t offset = 0;
-	while (count > 0) {
-		idx_t appended = state.current_segment->Append(state.append_state, vdata, offset, count);
-		if (appended == count) {
-			// appended everything: finished
-			return;
-		}
-		auto next_start = state.current_segment->start + state.current_segment->count;
-		// the segment is full: flush it to disk
-		state.FlushSegment(state.current_segment->FinalizeAppend(state.append_state));
+//===--------------------------------------------------------------------===//
+// Scan
+//===--------------------------------------------------------------------===//
+struct SuccinctScanState : public SegmentScanState {
+	//! The pinned block and header of a segment stored in the succinct format
+	BufferHandle handle;
+	SuccinctHeader header;
+};
 
-		// now create a new segment and continue appending
-		state.CreateEmptySegment(next_start);
-		offset += appended;
-		count -= appended;
+unique_ptr<SegmentScanState> SuccinctInitScan(ColumnSegment &segment) {
+	auto result = make_unique<SuccinctScanState>();
+	if (segment.succinct_possible) {
+		// the values are read from the representation the scan was initialized on
+		return move(result);
 	}
+	auto &buffer_manager = BufferManager::GetBufferManager(segment.db);
+	result->handle = buffer_manager.Pin(segment.block);
+	result->header = SuccinctHeader::Read(result->handle.Ptr() + segment.GetBlockOffset());
+	return move(result);
 }
 
-void FinalizeCompress(CompressionState &state_p) {
-	auto &state = (SuccinctCompressState &)state_p;
-	state.Finalize(state.current_segment->FinalizeAppend(state.append_state));
+static SuccinctHeader SuccinctGetScanHeader(ColumnSegment &segment, ColumnScanState &state) {
+	if (segment.succinct_possible) {
+		return SuccinctHeader::Get(*state.representation);
+	}
+	return ((SuccinctScanState &)*state.scan_state).header;
 }
-//===--------------------------------------------------------------------===//
-// Scan
-//===--------------------------------------------------------------------===//
+
 template <class T>
 void SuccinctScanPartial(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, Vector &result,
                          idx_t result_offset) {
 	auto start = segment.GetRelativeIndex(state.row_index);
-	auto source = segment.succinct_vec;
 	result.SetVectorType(VectorType::FLAT_VECTOR);
-	data_ptr_t target_ptr = FlatVector::GetData(result) + result_offset * sizeof(T);
-	/*
-	std::cout << "Start: " << start
-	          << ", Size: " << source.size()
-	          << ", Width: " << unsigned(source.width())
-	          << std::endl;
-	*/
-	for (idx_t i = 0; i < scan_count; ++i) {
-		auto entry_at_i = uint64_t(source[start + i]);
-		if (segment.GetMinFactor() != UINT64_MAX) {
-			entry_at_i += segment.GetMinFactor();
-		}
+	auto target_ptr = FlatVector::GetData<T>(result) + result_offset;
 
-		memcpy(target_ptr + i * sizeof(T), &entry_at_i, sizeof(T));
+	if (segment.succinct_possible) {
+		SuccinctEncoder::Decode<T>(*state.representation, start, scan_count, target_ptr);
+		return;
 	}
+	auto &header = ((SuccinctScanState &)*state.scan_state).header;
+	SuccinctPrimitives::UnPackBuffer<T>(target_ptr, header.packed, start, scan_count, header.width,
+	                                    header.frame_of_reference);
 }
 
 template <class T>
-void SuccinctScanAndCompact(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, Vector &result,
-                         idx_t result_offset) {
-	// TODO: FIX ME
-	auto source = segment.succinct_vec;
-	/*
-	uint64_t min = segment.GetCommonMinFactor();
-	uint64_t max = segment.GetMax() - segment.GetMinFactor();
-	std::cout << "Min: " << min << ", Max: " << segment.GetMax() << std::endl;
-	 */
-	uint64_t min = UINT64_MAX;
-	uint64_t max = 0;
-	if (DBConfig::GetConfig(segment.db).succinct_extract_prefix_enabled) {
-		auto min_max = std::minmax_element(source.begin(), source.end());
-
-		if (min_max.first != source.end()) {
-			min = *min_max.first;
-			//segment.UpdateMinFactor(min);
-		}
+void SuccinctScan(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, Vector &result) {
+	SuccinctScanPartial<T>(segment, state, scan_count, result, /* result_offset= */ 0);
+}
+//===--------------------------------------------------------------------===//
+// Fetch
+//===--------------------------------------------------------------------===//
+template <class T>
+void SuccinctFetchRow(ColumnSegment &segment, ColumnFetchState &state, row_t row_id, Vector &result,
+                      idx_t result_idx) {
+	if (segment.succinct_possible) {
+		SuccinctEncoder::Decode<T>(*state.representation, row_id, 1, FlatVector::GetData<T>(result) + result_idx);
+		return;
+	}
 
-    	if (min_max.second != source.end()) {
-        	max = *min_max.second;
-    	}
+	auto &buffer_manager = BufferManager::GetBufferManager(segment.db);
+	auto handle = buffer_manager.Pin(segment.block);
+	auto header = SuccinctHeader::Read(handle.Ptr() + segment.GetBlockOffset());
+	SuccinctPrimitives::UnPackBuffer<T>(FlatVector::GetData<T>(result) + result_idx, header.packed, row_id, 1,
+	                                    header.width, header.frame_of_reference);
+}
 
-		if (min != UINT64_MAX) {
-			// Decrease max by common min factor
-			max -= min;
+template <class T>
+void SuccinctFetchRows(ColumnSegment &segment, ColumnFetchState &state, const row_t *row_ids, idx_t count,
+                       Vector &result, idx_t result_offset) {
+	auto target_ptr = FlatVector::GetData<T>(result) + result_offset;
+	if (segment.succinct_possible) {
+		SuccinctEncoder::Fetch<T>(*state.representation, row_ids, count, target_ptr);
+		return;
+	}
+
+	// the block is pinned once for all rows
+	auto &buffer_manager = BufferManager::GetBufferManager(segment.db);
+	auto handle = buffer_manager.Pin(segment.block);
+	auto header = SuccinctHeader::Read(handle.Ptr() + segment.GetBlockOffset());
+	SuccinctPrimitives::FetchBuffer<T>(target_ptr, header.packed, row_ids, count, header.width,
+	                                   header.frame_of_reference);
+}
+//===--------------------------------------------------------------------===//
+// Filter
+//===--------------------------------------------------------------------===//
+//! Whether the filter can be evaluated on the packed values. Range comparisons need the packed values to be ordered
+//! like the values themselves.
+static bool SuccinctFilterIsSupported(const TableFilter &filter, PhysicalType type, bool ordered) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON: {
+		auto &constant_filter = (const ConstantFilter &)filter;
+		if (constant_filter.constant.IsNull() || constant_filter.constant.type().InternalType() != type) {
+			return false;
 		}
-	} else {
-		auto max_elem = std::max_element(source.begin(), source.end());
-		if (max_elem != source.begin() + segment.count) {
-        	max = *max_elem;
-    	}
+		switch (constant_filter.comparison_type) {
+		case ExpressionType::COMPARE_EQUAL:
+		case ExpressionType::COMPARE_NOTEQUAL:
+			return true;
+		case ExpressionType::COMPARE_LESSTHAN:
+		case ExpressionType::COMPARE_GREATERTHAN:
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+			return ordered;
+		default:
+			return false;
+		}
+	}
+	case TableFilterType::CONJUNCTION_AND: {
+		auto &conjunction_and = (const ConjunctionAndFilter &)filter;
+		for (auto &child_filter : conjunction_and.child_filters) {
+			if (!SuccinctFilterIsSupported(*child_filter, type, ordered)) {
+				return false;
+			}
+		}
+		return true;
 	}
+	default:
+		return false;
+	}
+}
 
-	//std::cout << "Searched min: " << min << ", Searched max: " << max << std::endl;
-	//std::cout << "Stored min: " << segment.GetMinFactor() << ", Stored Max: " << segment.GetMax() - segment.GetMinFactor() << std::endl;
-	//segment.UpdateMinFactor(min);
-	min = segment.GetMinFactor();
-	max = segment.GetMax() - segment.GetMinFactor();
+template <class OP>
+static idx_t SuccinctSelectOperation(const SuccinctHeader &header, idx_t start, SelectionVector &sel,
+                                     idx_t approved_tuple_count, uint64_t packed_constant,
+                                     SelectionVector &result_sel) {
+	return SuccinctPrimitives::SelectBuffer<OP>(header.packed, start, sel, approved_tuple_count, header.width,
+	                                            packed_constant, result_sel);
+}
 
-    uint8_t min_width = sdsl::bits::hi(max) + 1;
-	if (DBConfig::GetConfig(segment.db).succinct_padded_to_next_byte_enabled) {
-		min_width = ((min_width + 7) & (-8));
+template <bool EQUALS, class OP>
+static idx_t SuccinctSelectEquality(const SuccinctHeader &header, idx_t start, SelectionVector &sel,
+                                    idx_t approved_tuple_count, uint64_t packed_constant,
+                                    SelectionVector &result_sel) {
+	if (!sel.data() && 64 % header.width == 0) {
+		// all rows of the vector are candidates: compare whole words at once
+		return SuccinctPrimitives::SelectEqualsSWAR<EQUALS>(header.packed, start, approved_tuple_count,
+		                                                    header.width, packed_constant, result_sel);
 	}
-    uint8_t old_width = segment.succinct_vec.width();
+	return SuccinctSelectOperation<OP>(header, start, sel, approved_tuple_count, packed_constant, result_sel);
+}
 
-	if (old_width <= min_width) {
-		//std::cout << "Old width is smaller than min width: " << old_width << " <= " << min_width << std::endl;
-		return SuccinctScanPartial<T>(segment, state, scan_count, result, /* result_offset= */ 0);
+template <class T>
+static void SuccinctSelectConstant(const SuccinctHeader &header, bool ordered, idx_t start,
+                                   const ConstantFilter &filter, SelectionVector &sel, idx_t &approved_tuple_count) {
+	auto constant = filter.constant.GetValueUnsafe<T>();
+	const uint64_t max_packed =
+	    header.width == 64 ? NumericLimits<uint64_t>::Maximum() : (uint64_t(1) << header.width) - 1;
+	// rewrite the constant to the packed domain. This is exact for (in)equality even if the packed values are not
+	// ordered: both sides are compared on the sign-extended unsigned representation.
+	uint64_t packed_constant = uint64_t(constant) - header.frame_of_reference;
+	bool below = ordered && constant < T(header.frame_of_reference);
+	bool above = !below && packed_constant > max_packed;
+	auto comparison_type = filter.comparison_type;
+	if (below || above) {
+		// the constant lies outside of the values of the segment: the result does not depend on the values
+		bool all_match;
+		switch (comparison_type) {
+		case ExpressionType::COMPARE_EQUAL:
+			all_match = false;
+			break;
+		case ExpressionType::COMPARE_NOTEQUAL:
+			all_match = true;
+			break;
+		case ExpressionType::COMPARE_LESSTHAN:
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+			all_match = above;
+			break;
+		default:
+			all_match = below;
+			break;
+		}
+		if (!all_match) {
+			approved_tuple_count = 0;
+		}
+		return;
 	}
 
-	auto start = segment.GetRelativeIndex(state.row_index);
-	data_ptr_t target_ptr = FlatVector::GetData(result) + result_offset * sizeof(T);
-	result.SetVectorType(VectorType::FLAT_VECTOR);
+	SelectionVector new_sel(approved_tuple_count);
+	switch (comparison_type) {
+	case ExpressionType::COMPARE_EQUAL:
+		approved_tuple_count = SuccinctSelectEquality<true, Equals>(header, start, sel, approved_tuple_count,
+		                                                            packed_constant, new_sel);
+		break;
+	case ExpressionType::COMPARE_NOTEQUAL:
+		approved_tuple_count = SuccinctSelectEquality<false, NotEquals>(header, start, sel, approved_tuple_count,
+		                                                                packed_constant, new_sel);
+		break;
+	case ExpressionType::COMPARE_LESSTHAN:
+		approved_tuple_count =
+		    SuccinctSelectOperation<LessThan>(header, start, sel, approved_tuple_count, packed_constant, new_sel);
+		break;
+	case ExpressionType::COMPARE_GREATERTHAN:
+		approved_tuple_count =
+		    SuccinctSelectOperation<GreaterThan>(header, start, sel, approved_tuple_count, packed_constant, new_sel);
+		break;
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		approved_tuple_count = SuccinctSelectOperation<LessThanEquals>(header, start, sel, approved_tuple_count,
+		                                                               packed_constant, new_sel);
+		break;
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		approved_tuple_count = SuccinctSelectOperation<GreaterThanEquals>(header, start, sel, approved_tuple_count,
+		                                                                  packed_constant, new_sel);
+		break;
+	default:
+		throw InternalException("Unsupported comparison for succinct filter");
+	}
+	sel.Initialize(new_sel);
+}
 
-	const uint64_t* read_data = source.data();
-	uint64_t* write_data = source.data();
-	uint8_t read_offset = 0;
-	uint8_t write_offset = 0;
-	size_t size_before_compress = sdsl::size_in_bytes(source);
-
-	for (size_t i = 0; i < source.size(); ++i) {
-		if (i < scan_count) {
-			// Do actual scan and copy
-			auto entry_at_i = uint64_t(source[start + i]);
-			//std::cout << "Entry at i: " << entry_at_i << ", min: " << min << std::endl;
-			memcpy(target_ptr + i * sizeof(T), &entry_at_i, sizeof(T));
+template <class T>
+static void SuccinctSelect(const SuccinctHeader &header, bool ordered, idx_t start, const TableFilter &filter,
+                           SelectionVector &sel, idx_t &approved_tuple_count) {
+	if (filter.filter_type == TableFilterType::CONJUNCTION_AND) {
+		auto &conjunction_and = (const ConjunctionAndFilter &)filter;
+		for (auto &child_filter : conjunction_and.child_filters) {
+			if (approved_tuple_count == 0) {
+				return;
+			}
+			SuccinctSelect<T>(header, ordered, start, *child_filter, sel, approved_tuple_count);
 		}
+		return;
+	}
+	SuccinctSelectConstant<T>(header, ordered, start, (const ConstantFilter &)filter, sel, approved_tuple_count);
+}
 
-		uint64_t x = sdsl::bits::read_int_and_move(read_data, read_offset, old_width);
-		if (min != UINT64_MAX) {
-			x -= min;
-		}
-		sdsl::bits::write_int_and_move(write_data, x, write_offset, min_width);
+template <class T>
+bool SuccinctFilter(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, Vector &result,
+                    const TableFilter &filter, SelectionVector &sel, idx_t &approved_tuple_count) {
+	if (segment.succinct_possible && (!state.representation->compacted ||
+	                                  state.representation->encoding != SuccinctEncoding::FRAME_OF_REFERENCE)) {
+		// the values have not been rebased to the minimum of the segment yet, or are not stored one by one
+		return false;
+	}
+	auto start = segment.GetRelativeIndex(state.row_index);
+	if (segment.succinct_possible && state.representation->delta_vec &&
+	    start + scan_count > state.representation->packed_count) {
+		// appended rows are not packed yet
+		return false;
+	}
+	// compacted values are rebased to the minimum of the segment, so the packed values are ordered like the values
+	bool ordered = true;
+	auto header = SuccinctGetScanHeader(segment, state);
+	if (!SuccinctFilterIsSupported(filter, segment.type.InternalType(), ordered)) {
+		return false;
 	}
 
-	source.bit_resize(source.size() * min_width);
-	source.width(min_width);
-	segment.SetBitCompressed();
+	bool all_rows = !sel.data() && approved_tuple_count == scan_count;
+	SuccinctSelect<T>(header, ordered, start, filter, sel, approved_tuple_count);
 
-	int64_t diff_size = size_before_compress - sdsl::size_in_bytes(source);
-	BufferManager::GetBufferManager(segment.db).AddToDataSize(-diff_size);
-	segment.SetBitCompressed();
+	// only decode the values of the qualifying rows
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<T>(result);
+	if (all_rows && approved_tuple_count == scan_count) {
+		SuccinctPrimitives::UnPackBuffer<T>(result_data, header.packed, start, scan_count, header.width,
+		                                    header.frame_of_reference);
+		return true;
+	}
+	for (idx_t i = 0; i < approved_tuple_count; i++) {
+		auto idx = sel.get_index(i);
+		result_data[idx] =
+		    T(SuccinctPrimitives::UnPackValue(header.packed, start + idx, header.width) + header.frame_of_reference);
+	}
+	return true;
 }
 
+//===--------------------------------------------------------------------===//
+// Aggregate
+//===--------------------------------------------------------------------===//
+//! The frame of reference is the (sign-extended) minimum of the segment
 template <class T>
-void SuccinctScan(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, Vector &result) {
-	if (segment.IsBitCompressed()) {
-		SuccinctScanPartial<T>(segment, state, scan_count, result, /* result_offset= */ 0);
-	} else {
-		std::cout << "IS NOT BIT COMPRESSED" << std::endl;
-		SuccinctScanAndCompact<T>(segment, state, scan_count, result, /* result_offset= */ 0);
+static hugeint_t SuccinctFrameValue(uint64_t frame_of_reference) {
+	if (std::is_signed<T>::value) {
+		return hugeint_t(int64_t(frame_of_reference));
 	}
+	return Hugeint::Convert<uint64_t>(frame_of_reference);
 }
-//===--------------------------------------------------------------------===//
-// Fetch
-//===--------------------------------------------------------------------===//
+
+//! Aggregates packed values: every value is the frame of reference plus its packed value
 template <class T>
-void SuccinctFetchRow(ColumnSegment &segment, ColumnFetchState &state, row_t row_id, Vector &result,
-                      idx_t result_idx) {
-	auto source = segment.succinct_vec;
+static void SuccinctAggregatePacked(const SuccinctHeader &header, idx_t start, idx_t count,
+                                    SegmentAggregate &result) {
+	auto frame = SuccinctFrameValue<T>(header.frame_of_reference);
+	result.count += count;
+	if (!result.needs_min_max && header.width <= SuccinctPrimitives::SUM_PACKED_MAX_WIDTH) {
+		// narrow values are summed on the packed words, without unpacking them
+		auto packed_sum = SuccinctPrimitives::SumPacked(header.packed, start, count, header.width);
+		result.sum += frame * hugeint_t(int64_t(count)) + Hugeint::Convert<uint64_t>(packed_sum);
+		return;
+	}
 
-	data_ptr_t target_ptr = FlatVector::GetData(result) + result_idx * sizeof(T);
-	for (idx_t i = 0; i < source.size(); ++i) {
-		auto entry_at_i = source[i];
-		if (segment.GetMinFactor() != UINT64_MAX) {
-			entry_at_i += segment.GetMinFactor();
+	uint64_t buffer[STANDARD_VECTOR_SIZE];
+	hugeint_t packed_sum = 0;
+	uint64_t packed_min = NumericLimits<uint64_t>::Maximum();
+	uint64_t packed_max = 0;
+	for (idx_t offset = 0; offset < count; offset += STANDARD_VECTOR_SIZE) {
+		auto batch_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, count - offset);
+		SuccinctPrimitives::UnPackBuffer<uint64_t>(buffer, header.packed, start + offset, batch_count, header.width,
+		                                           0);
+		if (result.needs_sum) {
+			if (header.width <= 52) {
+				// a batch of up to 2^11 values below 2^52 cannot overflow 64 bits
+				uint64_t batch_sum = 0;
+				for (idx_t i = 0; i < batch_count; i++) {
+					batch_sum += buffer[i];
+				}
+				packed_sum += Hugeint::Convert<uint64_t>(batch_sum);
+			} else {
+				for (idx_t i = 0; i < batch_count; i++) {
+					packed_sum += Hugeint::Convert<uint64_t>(buffer[i]);
+				}
+			}
 		}
+		if (result.needs_min_max) {
+			for (idx_t i = 0; i < batch_count; i++) {
+				packed_min = MinValue<uint64_t>(packed_min, buffer[i]);
+				packed_max = MaxValue<uint64_t>(packed_max, buffer[i]);
+			}
+		}
+	}
+	if (result.needs_sum) {
+		result.sum += frame * hugeint_t(int64_t(count)) + packed_sum;
+	}
+	if (result.needs_min_max && count > 0) {
+		auto min = frame + Hugeint::Convert<uint64_t>(packed_min);
+		auto max = frame + Hugeint::Convert<uint64_t>(packed_max);
+		result.min = min < result.min ? min : result.min;
+		result.max = max > result.max ? max : result.max;
+	}
+}
 
-		for (idx_t j = 0; j < source.width() / 8; ++j) {
-			target_ptr[i * sizeof(T) + j] = entry_at_i >> j * 8;
+//! Aggregates values that are not stored one by one relative to the minimum by decoding them first
+template <class T>
+static void SuccinctAggregateDecoded(const SegmentRepresentation &representation, idx_t start, idx_t count,
+                                     SegmentAggregate &result) {
+	T buffer[STANDARD_VECTOR_SIZE];
+	for (idx_t offset = 0; offset < count; offset += STANDARD_VECTOR_SIZE) {
+		auto batch_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, count - offset);
+		SuccinctEncoder::Decode<T>(representation, start + offset, batch_count, buffer);
+		result.AddValues<T>(buffer, batch_count);
+	}
+}
+
+template <class T>
+bool SuccinctAggregate(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, SegmentAggregate &result) {
+	auto start = segment.GetRelativeIndex(state.row_index);
+	if (segment.succinct_possible) {
+		auto &representation = *state.representation;
+		if (!representation.compacted || representation.encoding != SuccinctEncoding::FRAME_OF_REFERENCE ||
+		    (representation.delta_vec && start + scan_count > representation.packed_count)) {
+			// the values are not rebased to the minimum, are not stored one by one or are (partly) appended rows
+			SuccinctAggregateDecoded<T>(representation, start, scan_count, result);
+			return true;
 		}
 	}
+	SuccinctAggregatePacked<T>(SuccinctGetScanHeader(segment, state), start, scan_count, result);
+	return true;
+}
+
+template <class T>
+static compression_aggregate_t SuccinctGetAggregate(std::true_type is_integral) {
+	return SuccinctAggregate<T>;
 }
+
+template <class T>
+static compression_aggregate_t SuccinctGetAggregate(std::false_type is_integral) {
+	return nullptr;
+}
+
 //===--------------------------------------------------------------------===//
 // Append
 //===--------------------------------------------------------------------===//
 static unique_ptr<CompressionAppendState> SuccinctInitAppend(ColumnSegment &segment) {
 	//std::cout << "Init append" << std::endl;
+	if (segment.succinct_possible) {
+		// the rows are appended to the representation, a compacted segment may not have a block anymore
+		return make_unique<CompressionAppendState>(BufferHandle());
+	}
 	auto &buffer_manager = BufferManager::GetBufferManager(segment.db);
 	auto handle = buffer_manager.Pin(segment.block);
 	return make_unique<CompressionAppendState>(move(handle));
 }
 
+//! The value that is stored in an uncompacted succinct vector: integers are truncated to the width of their type,
+//! FLOAT and DOUBLE values are stored as their bits
 template <class T>
-pair<uint64_t, uint64_t> SuccinctAppendLoop(SegmentStatistics &stats, sdsl::int_vector<> &target, idx_t target_offset, UnifiedVectorFormat &adata,
+static inline uint64_t SuccinctStoredValue(T value) {
+	return uint64_t(value);
+}
+
+template <>
+inline uint64_t SuccinctStoredValue(float value) {
+	return Load<uint32_t>((const_data_ptr_t)&value);
+}
+
+template <>
+inline uint64_t SuccinctStoredValue(double value) {
+	return Load<uint64_t>((const_data_ptr_t)&value);
+}
+
+template <class T>
+void SuccinctAppendLoop(SegmentStatistics &stats, sdsl::int_vector<> &target, idx_t target_offset, UnifiedVectorFormat &adata,
                        idx_t offset, idx_t count, PhysicalType type) {
-	uint64_t unsigned_min_factor = UINT64_MAX;
-	uint64_t unsigned_max_factor = 0;
 	auto sdata = (T *)adata.data;
 
 	if (!adata.validity.AllValid()) {
@@ -282,13 +670,11 @@ pair<uint64_t, uint64_t> SuccinctAppendLoop(SegmentStatistics &stats, sdsl::int_
 			bool is_null = !adata.validity.RowIsValid(source_idx);
 			if (!is_null) {
 				NumericStatistics::Update<T>(stats, sdata[source_idx]);
-				target[target_idx] = sdata[source_idx];
-				unsigned_min_factor = std::min(unsigned_min_factor, uint64_t(sdata[source_idx]));
-				unsigned_max_factor = std::max(unsigned_max_factor, uint64_t(sdata[source_idx]));
+				target[target_idx] = SuccinctStoredValue<T>(sdata[source_idx]);
 			} else {
 				// we insert a NullValue<T> in the null gap for debuggability
 				// this value should never be used or read anywhere
-				target[target_idx] = NullValue<T>();
+				target[target_idx] = SuccinctStoredValue<T>(NullValue<T>());
 			}
 		}
 	} else {
@@ -296,13 +682,9 @@ pair<uint64_t, uint64_t> SuccinctAppendLoop(SegmentStatistics &stats, sdsl::int_
 			auto source_idx = adata.sel->get_index(offset + i);
 			auto target_idx = target_offset + i;
 			NumericStatistics::Update<T>(stats, sdata[source_idx]);
-			target[target_idx] = sdata[source_idx];
-			unsigned_min_factor = std::min(unsigned_min_factor, uint64_t(sdata[source_idx]));
-			unsigned_max_factor = std::max(unsigned_max_factor, uint64_t(sdata[source_idx]));
+			target[target_idx] = SuccinctStoredValue<T>(sdata[source_idx]);
 		}
 	}
-
-	return {unsigned_min_factor, unsigned_max_factor};
 }
 
 template <class T>
@@ -313,9 +695,18 @@ idx_t SuccinctAppend(CompressionAppendState &append_state, ColumnSegment &segmen
 	idx_t max_tuple_count = segment.SegmentSize() / sizeof(T);
 	idx_t copy_count = MinValue<idx_t>(count, max_tuple_count - segment.count);
 
-	auto min_max = SuccinctAppendLoop<T>(stats, segment.succinct_vec, segment.count, data, offset, copy_count, segment.type.InternalType());
-	segment.UpdateMinFactor(min_max.first);
-	segment.UpdateMaxFactor(min_max.second);
+	// appends write rows that no scan can see yet, so they go straight into the published (uncompacted) vector, or
+	// into the delta buffer of a compacted one
+	auto representation = segment.GetRepresentation();
+	if (representation->compacted) {
+		D_ASSERT(representation->delta_vec);
+		D_ASSERT(segment.count + copy_count <= representation->packed_count + representation->delta_vec->size());
+		SuccinctAppendLoop<T>(stats, *representation->delta_vec, segment.count - representation->packed_count, data,
+		                      offset, copy_count, segment.type.InternalType());
+	} else {
+		SuccinctAppendLoop<T>(stats, *representation->succinct_vec, segment.count, data, offset, copy_count,
+		                      segment.type.InternalType());
+	}
 
 	segment.count += copy_count;
 	return copy_count;
@@ -329,17 +720,253 @@ idx_t SuccinctFinalizeAppend(ColumnSegment &segment, SegmentStatistics &stats) {
 	return segment.count * sizeof(T);
 }
 
+//===--------------------------------------------------------------------===//
+// Strings
+//===--------------------------------------------------------------------===//
+// VARCHAR segments are only compacted in memory, into a segment-local dictionary of their distinct strings and the
+// bit-packed codes of the rows. Checkpoints never choose this function, and appends uncompact the segment first.
+struct SuccinctStringScanState : public SegmentScanState {
+	//! The representation the strings of the scanned vector point into. The scan state outlives the vector, also when
+	//! the scan continues in the next segment.
+	shared_ptr<SegmentRepresentation> representation;
+};
+
+unique_ptr<AnalyzeState> SuccinctStringInitAnalyze(ColumnData &col_data, PhysicalType type) {
+	return make_unique<AnalyzeState>();
+}
+
+bool SuccinctStringAnalyze(AnalyzeState &state, Vector &input, idx_t count) {
+	return false;
+}
+
+idx_t SuccinctStringFinalAnalyze(AnalyzeState &state) {
+	return DConstants::INVALID_INDEX;
+}
+
+unique_ptr<SegmentScanState> SuccinctStringInitScan(ColumnSegment &segment) {
+	return make_unique<SuccinctStringScanState>();
+}
+
+void SuccinctStringScanPartial(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, Vector &result,
+                               idx_t result_offset) {
+	auto &scan_state = (SuccinctStringScanState &)*state.scan_state;
+	scan_state.representation = state.representation;
+	auto start = segment.GetRelativeIndex(state.row_index);
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	SuccinctEncoder::DecodeStrings(*state.representation, start, scan_count,
+	                               FlatVector::GetData<string_t>(result) + result_offset);
+}
+
+void SuccinctStringScan(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, Vector &result) {
+	SuccinctStringScanPartial(segment, state, scan_count, result, /* result_offset= */ 0);
+}
+
+void SuccinctStringFetchRow(ColumnSegment &segment, ColumnFetchState &state, row_t row_id, Vector &result,
+                            idx_t result_idx) {
+	auto &representation = *state.representation;
+	auto &codes = *representation.succinct_vec;
+	auto code = SuccinctPrimitives::UnPackValue(codes.data(), row_id, codes.width());
+	// the fetch releases the representation, so the string is copied into the result
+	FlatVector::GetData<string_t>(result)[result_idx] =
+	    StringVector::AddString(result, SuccinctEncoder::DecodeString(representation, code));
+}
+
+static bool SuccinctStringFilterIsSupported(const TableFilter &filter) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON: {
+		auto &constant_filter = (const ConstantFilter &)filter;
+		if (constant_filter.constant.IsNull() ||
+		    constant_filter.constant.type().InternalType() != PhysicalType::VARCHAR) {
+			return false;
+		}
+		switch (constant_filter.comparison_type) {
+		case ExpressionType::COMPARE_EQUAL:
+		case ExpressionType::COMPARE_NOTEQUAL:
+		case ExpressionType::COMPARE_LESSTHAN:
+		case ExpressionType::COMPARE_GREATERTHAN:
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+			return true;
+		default:
+			return false;
+		}
+	}
+	case TableFilterType::CONJUNCTION_AND:
+	case TableFilterType::CONJUNCTION_OR: {
+		auto &conjunction = (const ConjunctionFilter &)filter;
+		for (auto &child_filter : conjunction.child_filters) {
+			if (!SuccinctStringFilterIsSupported(*child_filter)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+//! Compare the codes of the rows with the code range of the strings that satisfy the comparison. The dictionary is
+//! sorted, so the strings below the first string not smaller than the constant have the codes below its code.
+static void SuccinctStringSelectConstant(const SegmentRepresentation &representation, const SuccinctHeader &header,
+                                         idx_t start, const ConstantFilter &filter, SelectionVector &sel,
+                                         idx_t &approved_tuple_count) {
+	auto constant = string_t(StringValue::Get(filter.constant));
+	auto dictionary_size = representation.auxiliary_vec->size();
+	auto code = SuccinctEncoder::LowerBoundString(representation, constant);
+	bool found =
+	    code < dictionary_size && Equals::Operation(SuccinctEncoder::DecodeString(representation, code), constant);
+
+	// rows with a code below 'bound' match (or, with 'below' false, the rows with a code of at least 'bound')
+	uint64_t bound;
+	bool below;
+	SelectionVector new_sel(approved_tuple_count);
+	switch (filter.comparison_type) {
+	case ExpressionType::COMPARE_EQUAL:
+		if (!found) {
+			approved_tuple_count = 0;
+		} else {
+			approved_tuple_count =
+			    SuccinctSelectEquality<true, Equals>(header, start, sel, approved_tuple_count, code, new_sel);
+			sel.Initialize(new_sel);
+		}
+		return;
+	case ExpressionType::COMPARE_NOTEQUAL:
+		if (found) {
+			approved_tuple_count =
+			    SuccinctSelectEquality<false, NotEquals>(header, start, sel, approved_tuple_count, code, new_sel);
+			sel.Initialize(new_sel);
+		}
+		return;
+	case ExpressionType::COMPARE_LESSTHAN:
+		bound = code;
+		below = true;
+		break;
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		bound = code + found;
+		below = true;
+		break;
+	case ExpressionType::COMPARE_GREATERTHAN:
+		bound = code + found;
+		below = false;
+		break;
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		bound = code;
+		below = false;
+		break;
+	default:
+		throw InternalException("Unsupported comparison for succinct string filter");
+	}
+	if (bound == 0 || bound == dictionary_size) {
+		// either all or none of the codes lie below the bound
+		if ((bound == 0) == below) {
+			approved_tuple_count = 0;
+		}
+		return;
+	}
+	if (below) {
+		approved_tuple_count =
+		    SuccinctSelectOperation<LessThan>(header, start, sel, approved_tuple_count, bound, new_sel);
+	} else {
+		approved_tuple_count =
+		    SuccinctSelectOperation<GreaterThanEquals>(header, start, sel, approved_tuple_count, bound, new_sel);
+	}
+	sel.Initialize(new_sel);
+}
+
+static void SuccinctStringSelect(const SegmentRepresentation &representation, const SuccinctHeader &header,
+                                 idx_t start, const TableFilter &filter, SelectionVector &sel,
+                                 idx_t &approved_tuple_count) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONJUNCTION_AND: {
+		auto &conjunction_and = (const ConjunctionAndFilter &)filter;
+		for (auto &child_filter : conjunction_and.child_filters) {
+			if (approved_tuple_count == 0) {
+				return;
+			}
+			SuccinctStringSelect(representation, header, start, *child_filter, sel, approved_tuple_count);
+		}
+		return;
+	}
+	case TableFilterType::CONJUNCTION_OR: {
+		// e.g. an IN list: a row qualifies if any of the children selects it
+		bool matches[STANDARD_VECTOR_SIZE] = {};
+		auto &conjunction_or = (const ConjunctionOrFilter &)filter;
+		for (auto &child_filter : conjunction_or.child_filters) {
+			SelectionVector child_sel;
+			child_sel.Initialize(sel);
+			idx_t child_count = approved_tuple_count;
+			SuccinctStringSelect(representation, header, start, *child_filter, child_sel, child_count);
+			for (idx_t i = 0; i < child_count; i++) {
+				matches[child_sel.get_index(i)] = true;
+			}
+		}
+		SelectionVector new_sel(approved_tuple_count);
+		idx_t result_count = 0;
+		for (idx_t i = 0; i < approved_tuple_count; i++) {
+			auto idx = sel.get_index(i);
+			if (matches[idx]) {
+				new_sel.set_index(result_count++, idx);
+			}
+		}
+		sel.Initialize(new_sel);
+		approved_tuple_count = result_count;
+		return;
+	}
+	default:
+		SuccinctStringSelectConstant(representation, header, start, (const ConstantFilter &)filter, sel,
+		                             approved_tuple_count);
+		return;
+	}
+}
+
+bool SuccinctStringFilter(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, Vector &result,
+                          const TableFilter &filter, SelectionVector &sel, idx_t &approved_tuple_count) {
+	if (!SuccinctStringFilterIsSupported(filter)) {
+		return false;
+	}
+	auto &representation = *state.representation;
+	auto &scan_state = (SuccinctStringScanState &)*state.scan_state;
+	scan_state.representation = state.representation;
+	auto start = segment.GetRelativeIndex(state.row_index);
+	auto header = SuccinctHeader::Get(representation);
+	SuccinctStringSelect(representation, header, start, filter, sel, approved_tuple_count);
+
+	// only look up the strings of the qualifying rows
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<string_t>(result);
+	for (idx_t i = 0; i < approved_tuple_count; i++) {
+		auto idx = sel.get_index(i);
+		auto code = SuccinctPrimitives::UnPackValue(header.packed, start + idx, header.width);
+		result_data[idx] = SuccinctEncoder::DecodeString(representation, code);
+	}
+	return true;
+}
+
+CompressionFunction SuccinctStringGetFunction() {
+	// appends go to the uncompressed function of the segment, which uncompacts a compacted string segment first
+	return CompressionFunction(CompressionType::COMPRESSION_SUCCINCT, PhysicalType::VARCHAR,
+	                           SuccinctStringInitAnalyze, SuccinctStringAnalyze, SuccinctStringFinalAnalyze, nullptr,
+	                           nullptr, nullptr, SuccinctStringInitScan, SuccinctStringScan, SuccinctStringScanPartial,
+	                           SuccinctStringFetchRow, UncompressedFunctions::EmptySkip, nullptr, nullptr, nullptr,
+	                           nullptr, nullptr, SuccinctStringFilter);
+}
+
 //===--------------------------------------------------------------------===//
 // Get Function
 //===--------------------------------------------------------------------===//
 template <class T>
 CompressionFunction SuccinctGetFunction(PhysicalType type) {
-	return CompressionFunction(CompressionType::COMPRESSION_SUCCINCT, type, FixedSizeInitAnalyze,
-	                           FixedSizeAnalyze, FixedSizeFinalAnalyze<T>, InitCompression,
-	                           Compress, FinalizeCompress,
-	                           FixedSizeInitScan, SuccinctScan<T>, SuccinctScanPartial<T>, SuccinctFetchRow<T>,
+	// FLOAT and DOUBLE values are not stored in order (or one by one), so filters are evaluated after decoding them
+	// and they are not aggregated on the compressed data
+	return CompressionFunction(CompressionType::COMPRESSION_SUCCINCT, type, SuccinctInitAnalyze<T>,
+	                           SuccinctAnalyze<T>, SuccinctFinalAnalyze<T>, SuccinctInitCompression<T>,
+	                           SuccinctCompress<T>, SuccinctFinalizeCompress<T>,
+	                           SuccinctInitScan, SuccinctScan<T>, SuccinctScanPartial<T>, SuccinctFetchRow<T>,
 	                           UncompressedFunctions::EmptySkip, nullptr, SuccinctInitAppend, SuccinctAppend<T>,
-	                           SuccinctFinalizeAppend<T>, nullptr);
+	                           SuccinctFinalizeAppend<T>, nullptr,
+	                           std::is_floating_point<T>::value ? nullptr : SuccinctFilter<T>, SuccinctFetchRows<T>,
+	                           SuccinctGetAggregate<T>(std::is_integral<T>()));
 }
 
 CompressionFunction SuccinctFun::GetFunction(PhysicalType data_type) {
@@ -360,6 +987,12 @@ CompressionFunction SuccinctFun::GetFunction(PhysicalType data_type) {
 		return SuccinctGetFunction<int64_t>(data_type);
 	case PhysicalType::UINT64:
 		return SuccinctGetFunction<uint64_t>(data_type);
+	case PhysicalType::FLOAT:
+		return SuccinctGetFunction<float>(data_type);
+	case PhysicalType::DOUBLE:
+		return SuccinctGetFunction<double>(data_type);
+	case PhysicalType::VARCHAR:
+		return SuccinctStringGetFunction();
 	default:
 		throw InternalException("Unsupported type for FixedSizeSuccinct::GetFunction");
 	}
@@ -375,6 +1008,9 @@ bool SuccinctFun::TypeIsSupported(PhysicalType type) {
 	case PhysicalType::UINT16:
 	case PhysicalType::UINT32:
 	case PhysicalType::UINT64:
+	case PhysicalType::FLOAT:
+	case PhysicalType::DOUBLE:
+	case PhysicalType::VARCHAR:
 		return true;
 	default:
 		return false;
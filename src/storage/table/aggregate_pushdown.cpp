@@ -0,0 +1,116 @@
+#include "duckdb/storage/table/aggregate_pushdown.hpp"
+
+namespace duckdb {
+
+AggregatePushdown::AggregatePushdown(vector<PushdownAggregate> aggregates_p, idx_t column_count)
+    : aggregates(move(aggregates_p)), aggregated(column_count, false), needs_sum(column_count, false),
+      needs_min_max(column_count, false), row_count(0) {
+	for (auto &aggregate : aggregates) {
+		switch (aggregate.type) {
+		case PushdownAggregateType::COUNT_STAR:
+			break;
+		case PushdownAggregateType::COUNT:
+			aggregated[aggregate.column_index] = true;
+			break;
+		case PushdownAggregateType::SUM:
+			aggregated[aggregate.column_index] = true;
+			needs_sum[aggregate.column_index] = true;
+			break;
+		case PushdownAggregateType::MIN:
+		case PushdownAggregateType::MAX:
+			aggregated[aggregate.column_index] = true;
+			needs_min_max[aggregate.column_index] = true;
+			break;
+		default:
+			throw InternalException("Unrecognized pushdown aggregate type");
+		}
+	}
+	for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+		column_aggregates.push_back(InitializeColumn(col_idx));
+	}
+}
+
+SegmentAggregate AggregatePushdown::InitializeColumn(idx_t column_index) const {
+	return SegmentAggregate(needs_sum[column_index], needs_min_max[column_index]);
+}
+
+void AggregatePushdown::Reset() {
+	lock_guard<mutex> guard(lock);
+	row_count = 0;
+	for (auto &column_aggregate : column_aggregates) {
+		column_aggregate.Reset();
+	}
+}
+
+void AggregatePushdown::Combine(idx_t scan_row_count, const vector<SegmentAggregate> &scan_aggregates) {
+	D_ASSERT(scan_aggregates.size() == column_aggregates.size());
+	lock_guard<mutex> guard(lock);
+	row_count += scan_row_count;
+	for (idx_t col_idx = 0; col_idx < column_aggregates.size(); col_idx++) {
+		column_aggregates[col_idx].Combine(scan_aggregates[col_idx]);
+	}
+}
+
+Value AggregatePushdown::Finalize(idx_t aggr_idx, const Value &result) {
+	D_ASSERT(aggr_idx < aggregates.size());
+	lock_guard<mutex> guard(lock);
+	auto &aggregate = aggregates[aggr_idx];
+	if (aggregate.type == PushdownAggregateType::COUNT_STAR) {
+		return Value::BIGINT(result.GetValue<int64_t>() + int64_t(row_count));
+	}
+	auto &column_aggregate = column_aggregates[aggregate.column_index];
+	if (aggregate.type == PushdownAggregateType::COUNT) {
+		return Value::BIGINT(result.GetValue<int64_t>() + int64_t(column_aggregate.count));
+	}
+	if (column_aggregate.count == 0) {
+		// the scans did not aggregate any values of the column
+		return result;
+	}
+	// the values are combined as HUGEINT, casting back to the result type fails if the result does not fit
+	hugeint_t value;
+	switch (aggregate.type) {
+	case PushdownAggregateType::SUM:
+		value = column_aggregate.sum;
+		if (!result.IsNull()) {
+			value += result.DefaultCastAs(LogicalType::HUGEINT).GetValue<hugeint_t>();
+		}
+		break;
+	case PushdownAggregateType::MIN:
+		value = column_aggregate.min;
+		if (!result.IsNull()) {
+			auto result_value = result.DefaultCastAs(LogicalType::HUGEINT).GetValue<hugeint_t>();
+			value = result_value < value ? result_value : value;
+		}
+		break;
+	case PushdownAggregateType::MAX:
+		value = column_aggregate.max;
+		if (!result.IsNull()) {
+			auto result_value = result.DefaultCastAs(LogicalType::HUGEINT).GetValue<hugeint_t>();
+			value = result_value > value ? result_value : value;
+		}
+		break;
+	default:
+		throw InternalException("Unrecognized pushdown aggregate type");
+	}
+	return Value::HUGEINT(value).DefaultCastAs(result.type());
+}
+
+AggregatePushdownState::AggregatePushdownState(AggregatePushdown &pushdown) : pushdown(pushdown), row_count(0) {
+	for (idx_t col_idx = 0; col_idx < pushdown.aggregated.size(); col_idx++) {
+		column_aggregates.push_back(pushdown.InitializeColumn(col_idx));
+		vector_aggregates.push_back(pushdown.InitializeColumn(col_idx));
+	}
+}
+
+void AggregatePushdownState::Flush() {
+	if (row_count == 0) {
+		return;
+	}
+	pushdown.Combine(row_count, column_aggregates);
+	row_count = 0;
+	for (auto &column_aggregate : column_aggregates) {
+		column_aggregate.Reset();
+	}
+}
+
+} // namespace duckdb
@@ -8,6 +8,7 @@
 #include "duckdb/storage/statistics/distinct_statistics.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/storage/table/column_data_checkpointer.hpp"
+#include "duckdb/storage/table/column_succinct_metadata.hpp"
 #include "duckdb/storage/table/list_column_data.hpp"
 #include "duckdb/storage/table/standard_column_data.hpp"
 #include "duckdb/transaction/transaction.hpp"
@@ -23,11 +24,15 @@ ColumnData::ColumnData(BlockManager &block_manager, DataTableInfo &info, idx_t c
                        LogicalType type, ColumnData *parent)
     : block_manager(block_manager), info(info), column_index(column_index), start(start_row), type(move(type)),
       parent(parent), version(0) {
+	if (ColumnSuccinctMetadata::TypeIsSupported(this->type.InternalType())) {
+		succinct_metadata = make_shared<ColumnSuccinctMetadata>();
+	}
 }
 
 ColumnData::ColumnData(ColumnData &other, idx_t start, ColumnData *parent)
     : block_manager(other.block_manager), info(other.info), column_index(other.column_index), start(start),
-      type(move(other.type)), parent(parent), updates(move(other.updates)), version(parent ? parent->version + 1 : 0) {
+      type(move(other.type)), parent(parent), updates(move(other.updates)), version(parent ? parent->version + 1 : 0),
+      succinct_metadata(other.succinct_metadata) {
 	idx_t offset = 0;
 	for (auto segment = other.data.GetRootSegment(); segment; segment = segment->Next()) {
 		auto &other = (ColumnSegment &)*segment;
@@ -58,6 +63,10 @@ void ColumnData::IncrementVersion() {
 	version++;
 }
 
+bool ColumnData::CheckZonemapRange(ColumnScanState &state, idx_t end_row, TableFilter &filter) {
+	return true;
+}
+
 idx_t ColumnData::GetMaxEntry() {
 	auto l = data.Lock();
 	auto first_segment = data.GetRootSegment(l);
@@ -89,7 +98,7 @@ void ColumnData::InitializeScanWithOffset(ColumnScanState &state, idx_t row_idx)
 	state.scan_state.reset();
 }
 
-idx_t ColumnData::ScanVector(ColumnScanState &state, Vector &result, idx_t remaining) {
+void ColumnData::BeginScanVectorInternal(ColumnScanState &state) {
 	state.previous_states.clear();
 	if (state.version != version) {
 		InitializeScanWithOffset(state, state.row_index);
@@ -108,6 +117,18 @@ idx_t ColumnData::ScanVector(ColumnScanState &state, Vector &result, idx_t remai
 		state.current->Skip(state);
 	}
 	D_ASSERT(state.current->type == type);
+}
+
+idx_t ColumnData::ScanVector(ColumnScanState &state, Vector &result, idx_t remaining) {
+	BeginScanVectorInternal(state);
+	// the segments rebased on the shared frame of the column are all decoded with its unpack kernel
+	shared_ptr<const SharedSuccinctFrame> shared_frames[2];
+	bool has_shared_frame = false;
+	if (succinct_metadata) {
+		shared_frames[0] = succinct_metadata->GetFrame(false);
+		shared_frames[1] = succinct_metadata->GetFrame(true);
+		has_shared_frame = shared_frames[0] || shared_frames[1];
+	}
 	idx_t initial_remaining = remaining;
 	while (remaining > 0) {
 		D_ASSERT(state.row_index >= state.current->start &&
@@ -115,7 +136,10 @@ idx_t ColumnData::ScanVector(ColumnScanState &state, Vector &result, idx_t remai
 		idx_t scan_count = MinValue<idx_t>(remaining, state.current->start + state.current->count - state.row_index);
 		idx_t result_offset = initial_remaining - remaining;
 		if (scan_count > 0) {
-			state.current->Scan(state, scan_count, result, result_offset, scan_count == initial_remaining);
+			if (!has_shared_frame ||
+			    !state.current->ScanShared(state, shared_frames, scan_count, result, result_offset)) {
+				state.current->Scan(state, scan_count, result, result_offset, scan_count == initial_remaining);
+			}
 
 			state.row_index += scan_count;
 			remaining -= scan_count;
@@ -129,6 +153,7 @@ idx_t ColumnData::ScanVector(ColumnScanState &state, Vector &result, idx_t remai
 			state.current = (ColumnSegment *)state.current->Next();
 			state.current->InitializeScan(state);
 			state.segment_checked = false;
+			state.segment_pruned = false;
 			D_ASSERT(state.row_index >= state.current->start &&
 			         state.row_index <= state.current->start + state.current->count);
 		}
@@ -201,6 +226,39 @@ void ColumnData::Select(TransactionData transaction, idx_t vector_index, ColumnS
 	idx_t scan_count = Scan(transaction, vector_index, state, result);
 	result.Flatten(scan_count);
 	ColumnSegment::FilterSelection(sel, result, filter, count, FlatVector::Validity(result));
+	if (count > 0 && state.current) {
+		// the rows are attributed to the segment the vector ends in
+		state.current->RecordQualifyingRead();
+	}
+}
+
+bool ColumnData::SelectCompressed(TransactionData transaction, idx_t vector_index, ColumnScanState &state,
+                                  Vector &result, SelectionVector &sel, idx_t &count, const TableFilter &filter) {
+	{
+		lock_guard<mutex> update_guard(update_lock);
+		if (updates) {
+			// the compressed data does not contain the updates
+			return false;
+		}
+	}
+	BeginScanVectorInternal(state);
+	auto segment = state.current;
+	D_ASSERT(state.row_index >= segment->start && state.row_index <= segment->start + segment->count);
+	idx_t scan_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, segment->start + segment->count - state.row_index);
+	if (scan_count == 0 || (scan_count < STANDARD_VECTOR_SIZE && segment->next)) {
+		// the vector spans multiple segments
+		return false;
+	}
+	if (!segment->FilterCompressed(state, scan_count, result, filter, sel, count)) {
+		return false;
+	}
+	state.row_index += scan_count;
+	state.internal_index = state.row_index;
+	return true;
+}
+
+bool ColumnData::AggregateCompressed(ColumnScanState &state, idx_t count, SegmentAggregate &result) {
+	return false;
 }
 
 void ColumnData::FilterScan(TransactionData transaction, idx_t vector_index, ColumnScanState &state, Vector &result,
@@ -314,6 +372,29 @@ void ColumnData::FetchRow(TransactionData transaction, ColumnFetchState &state,
 	}
 }
 
+void ColumnData::FetchRows(TransactionData transaction, ColumnFetchState &state, const row_t *row_ids, idx_t count,
+                           Vector &result, idx_t result_offset) {
+	idx_t row_idx = 0;
+	while (row_idx < count) {
+		auto segment = (ColumnSegment *)data.GetSegment(row_ids[row_idx]);
+		// fetch all consecutive rows that belong to this segment at once
+		idx_t segment_count = 1;
+		while (row_idx + segment_count < count && idx_t(row_ids[row_idx + segment_count]) >= segment->start &&
+		       idx_t(row_ids[row_idx + segment_count]) < segment->start + segment->count) {
+			segment_count++;
+		}
+		segment->FetchRows(state, row_ids + row_idx, segment_count, result, result_offset + row_idx);
+		row_idx += segment_count;
+	}
+	// merge any updates made to these rows
+	lock_guard<mutex> update_guard(update_lock);
+	if (updates) {
+		for (idx_t i = 0; i < count; i++) {
+			updates->FetchRow(transaction, row_ids[i], result, result_offset + i);
+		}
+	}
+}
+
 void ColumnData::Update(TransactionData transaction, idx_t column_index, Vector &update_vector, row_t *row_ids,
                         idx_t update_count) {
 	lock_guard<mutex> update_guard(update_lock);
@@ -350,7 +431,11 @@ void ColumnData::AppendTransientSegment(SegmentLock &l, idx_t start_row) {
 #endif
 	}
 	//std::cout << "Internal type id size: " << GetTypeIdSize(type.InternalType()) << std::endl;
-	auto new_segment = ColumnSegment::CreateTransientSegment(GetDatabase(), type, start_row, segment_size);
+	auto new_segment = ColumnSegment::CreateTransientSegment(GetDatabase(), type, start_row, segment_size,
+	                                                          /* compactable= */ true);
+	if (new_segment->succinct_possible) {
+		new_segment->column_metadata = succinct_metadata;
+	}
 	data.AppendSegment(l, move(new_segment));
 }
 
@@ -1,16 +1,24 @@
 #include "duckdb/storage/table/column_segment.hpp"
 
 #include "duckdb/common/limits.hpp"
+#include "duckdb/common/profiler.hpp"
+#include "duckdb/common/perf_events.hpp"
+#include "duckdb/common/succinct_primitives.hpp"
+#include "duckdb/common/types/hugeint.hpp"
 #include "duckdb/common/types/null_value.hpp"
 #include "duckdb/common/types/vector.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/function/compression/compression.hpp"
 #include "duckdb/main/config.hpp"
 #include "duckdb/planner/filter/conjunction_filter.hpp"
 #include "duckdb/planner/filter/constant_filter.hpp"
 #include "duckdb/planner/filter/null_filter.hpp"
 #include "duckdb/storage/statistics/numeric_statistics.hpp"
 #include "duckdb/storage/storage_manager.hpp"
+#include "duckdb/storage/string_uncompressed.hpp"
 #include "duckdb/storage/table/append_state.hpp"
+#include "duckdb/storage/table/column_succinct_metadata.hpp"
+#include "duckdb/storage/table/segment_spill_file.hpp"
 #include "duckdb/storage/table/update_segment.hpp"
 
 #include <algorithm>
@@ -34,31 +42,33 @@ unique_ptr<ColumnSegment> ColumnSegment::CreatePersistentSegment(DatabaseInstanc
 		function = config.GetCompressionFunction(compression_type, type.InternalType());
 		block = block_manager.RegisterBlock(block_id);
 	}
-	bool is_data_segment = TypeIsInteger(type.InternalType());
+	bool is_data_segment = TypeIsNumeric(type.InternalType()) || type.InternalType() == PhysicalType::VARCHAR;
 
 	auto segment_size = Storage::BLOCK_SIZE;
 	return make_unique<ColumnSegment>(db, move(block), type, ColumnSegmentType::PERSISTENT, start, count, function,
 	                                  move(statistics), block_id, offset, segment_size,
-	                                  /* succinct_possible= */ false, config.adaptive_succinct_compression_enabled, is_data_segment);
+	                                  /* succinct_possible= */ false, is_data_segment);
 }
 
 unique_ptr<ColumnSegment> ColumnSegment::CreateTransientSegment(DatabaseInstance &db, const LogicalType &type,
-                                                                idx_t start, idx_t segment_size) {
+                                                                idx_t start, idx_t segment_size, bool compactable) {
 
 	auto &config = DBConfig::GetConfig(db);
 
 	CompressionFunction* function;
 	auto &buffer_manager = BufferManager::GetBufferManager(db);
 	shared_ptr<BlockHandle> block;
-	bool succinct_possible = false;
+	// segments that are filled by a compression function during a checkpoint are plain buffers: they must never be
+	// replaced by (or turned into) an in-memory succinct vector
+	bool succinct_possible = compactable && SuccinctFun::TypeIsSupported(type.InternalType()) && config.succinct_enabled;
 
-	if (TypeIsInteger(type.InternalType()) && config.succinct_enabled && !config.adaptive_succinct_compression_enabled) {
+	// strings are appended to an uncompressed block and only compacted into a dictionary later on
+	if (succinct_possible && !config.adaptive_succinct_compression_enabled &&
+	    type.InternalType() != PhysicalType::VARCHAR) {
 		//std::cout << "Create SUCCINCT transient segment with size "<< segment_size << std::endl;
-		succinct_possible = true;
 		function = config.GetCompressionFunction(CompressionType::COMPRESSION_SUCCINCT, type.InternalType());
 		block = buffer_manager.RegisterSmallMemory(1);
 	} else {
-		succinct_possible = TypeIsInteger(type.InternalType()) && config.succinct_enabled;
 		function = config.GetCompressionFunction(CompressionType::COMPRESSION_UNCOMPRESSED, type.InternalType());
 		/*
 		std::cout << "Create UNCOMPRESSED transient segment with size " << segment_size
@@ -74,11 +84,10 @@ unique_ptr<ColumnSegment> ColumnSegment::CreateTransientSegment(DatabaseInstance
 		buffer_manager.AddOnlyToDataSize(segment_size);
 	}
 
-	bool is_data_segment = TypeIsInteger(type.InternalType());
+	bool is_data_segment = TypeIsNumeric(type.InternalType()) || type.InternalType() == PhysicalType::VARCHAR;
 
 	return make_unique<ColumnSegment>(db, move(block), type, ColumnSegmentType::TRANSIENT, start, 0, function, nullptr,
-	                                  INVALID_BLOCK, 0, segment_size, succinct_possible,
-	                                  config.adaptive_succinct_compression_enabled, is_data_segment);
+	                                  INVALID_BLOCK, 0, segment_size, succinct_possible, is_data_segment);
 }
 
 unique_ptr<ColumnSegment> ColumnSegment::CreateSegment(ColumnSegment &other, idx_t start) {
@@ -88,50 +97,99 @@ unique_ptr<ColumnSegment> ColumnSegment::CreateSegment(ColumnSegment &other, idx
 ColumnSegment::ColumnSegment(DatabaseInstance &db, shared_ptr<BlockHandle> block, LogicalType type_p,
                              ColumnSegmentType segment_type, idx_t start, idx_t count, CompressionFunction *function_p,
                              unique_ptr<BaseStatistics> statistics, block_id_t block_id_p, idx_t offset_p,
-                             idx_t segment_size_p, bool succinct_possible, bool background_compaction_enabled, bool is_data_segment)
+                             idx_t segment_size_p, bool succinct_possible, bool is_data_segment)
     : SegmentBase(start, count), db(db), type(move(type_p)), type_size(GetTypeIdSize(type.InternalType())),
       segment_type(segment_type), function(function_p), stats(type, move(statistics)), block(move(block)),
-      block_id(block_id_p), offset(offset_p), segment_size(segment_size_p),
-      num_elements(0), min_factor(UINT64_MAX), max_factor(0), compacted(false),
-      succinct_possible(succinct_possible), background_compaction_enabled(background_compaction_enabled), is_data_segment(is_data_segment),
-      column_segment_catalog(Catalog::GetSystemCatalog(db).GetColumnSegmentCatalog()),
-      force_reinitializing_scan_state(false) {
+      succinct_possible(succinct_possible), is_data_segment(is_data_segment), prefetch_scheduled(false),
+      catalog_pins(0), num_elements(0), block_id(block_id_p), offset(offset_p), segment_size(segment_size_p), compacted(false),
+      has_uncompressed_block(false), column_segment_catalog(Catalog::GetSystemCatalog(db).GetColumnSegmentCatalog()),
+      counted_reclaimable(false), counted_spillable(false) {
 	D_ASSERT(function);
 
-	if (function->type == CompressionType::COMPRESSION_SUCCINCT) {
-		succinct_vec.width(type_size * 8);
-		succinct_vec.resize(segment_size / type_size);
-		BufferManager::GetBufferManager(db).AddToDataSize(sdsl::size_in_bytes(succinct_vec));
+	if (succinct_possible) {
+		representation = make_shared<SegmentRepresentation>();
+		representation->function = function;
+		representation->published_at = Timestamp::GetCurrentTimestamp();
+		if (HasSuccinctVector()) {
+			representation->succinct_vec =
+			    make_shared<sdsl::int_vector<>>(segment_size / type_size, 0, type_size * 8);
+			BufferManager::GetBufferManager(db).AddToDataSize(sdsl::size_in_bytes(*representation->succinct_vec));
+		} else {
+			has_uncompressed_block = true;
+			block_representation = representation;
+		}
 	}
 
 	if (function->init_segment) {
 		segment_state = function->init_segment(*this, block_id);
 	}
+
+	column_segment_catalog->AddColumnSegment(this);
+	UpdateReclaimState();
 }
 
 ColumnSegment::ColumnSegment(ColumnSegment &other, idx_t start)
     : SegmentBase(start, other.count), db(other.db), type(move(other.type)), type_size(other.type_size),
       segment_type(other.segment_type), function(other.function), stats(move(other.stats)), block(move(other.block)),
-      block_id(other.block_id), offset(other.offset), segment_size(other.segment_size), num_elements(other.num_elements),
-      segment_state(move(other.segment_state)), compacted(other.compacted),
-      min_factor(other.min_factor), max_factor(other.max_factor),
-      column_segment_catalog(other.column_segment_catalog), succinct_possible(other.succinct_possible),
-      background_compaction_enabled(other.background_compaction_enabled), is_data_segment(other.is_data_segment),
-      force_reinitializing_scan_state(other.force_reinitializing_scan_state) {
-
-	succinct_vec = std::move(other.succinct_vec);
+      succinct_possible(other.succinct_possible), is_data_segment(other.is_data_segment), prefetch_scheduled(false),
+      catalog_pins(0), num_elements(other.num_elements), block_id(other.block_id), offset(other.offset),
+      segment_size(other.segment_size), segment_state(move(other.segment_state)),
+      representation(move(other.representation)), compacted(other.compacted.load()),
+      has_uncompressed_block(other.has_uncompressed_block), block_representation(other.block_representation),
+      column_segment_catalog(other.column_segment_catalog), counted_reclaimable(false), counted_spillable(false) {
+
+	access_statistics.num_reads = other.access_statistics.num_reads.load();
+	access_statistics.num_scans = other.access_statistics.num_scans.load();
+	column_metadata = other.column_metadata;
 	column_segment_catalog->AddColumnSegment(this);
+	UpdateReclaimState();
 }
 
 ColumnSegment::~ColumnSegment() {
 	column_segment_catalog->RemoveColumnSegment(this);
+	column_segment_catalog->UpdateReclaimableSegments(counted_reclaimable, false, counted_spillable, false);
+	auto current = GetRepresentation();
+	if (!current) {
+		return;
+	}
+	// the succinct vectors are freed once the last scan that reads them finishes
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	if (current->succinct_vec || current->spilled) {
+		buffer_manager.AddToDataSize(-int64_t(current->SizeInBytes()));
+	} else {
+		buffer_manager.AddOnlyToDataSize(-int64_t(segment_size));
+	}
 }
 
 //===--------------------------------------------------------------------===//
 // Scan
 //===--------------------------------------------------------------------===//
 void ColumnSegment::InitializeScan(ColumnScanState &state) {
-	state.scan_state = function->init_scan(*this);
+	if (!succinct_possible) {
+		state.representation.reset();
+		state.scan_state = function->init_scan(*this);
+		return;
+	}
+	// the scan keeps reading this representation, even if the segment is (un)compacted in the meantime
+	state.representation = GetRepresentation();
+	if (state.representation->spilled) {
+		state.representation = LoadSpilled();
+	}
+	state.scan_state = state.representation->function->init_scan(*this);
+	if (column_segment_catalog->SpillEnabled()) {
+		PrefetchNext();
+	}
+}
+
+void ColumnSegment::PrefetchNext() {
+	auto next_segment = (ColumnSegment *)next.load();
+	if (next_segment && next_segment->IsSpilled()) {
+		column_segment_catalog->PrefetchSegment(next_segment);
+	}
+}
+
+CompressionFunction &ColumnSegment::GetScanFunction(ColumnScanState &state) {
+	return state.representation ? *state.representation->function : *function;
 }
 
 void ColumnSegment::Scan(ColumnScanState &state, idx_t scan_count, Vector &result, idx_t result_offset,
@@ -146,52 +204,213 @@ void ColumnSegment::Scan(ColumnScanState &state, idx_t scan_count, Vector &resul
 	}
 }
 
+bool ColumnSegment::MeasureKernels() const {
+	// the validity and row id segments would blur the counters of the data they belong to
+	return is_data_segment && column_segment_catalog->PerfEventsEnabled();
+}
+
+//! The bit width of the values an operation decodes, 0 if they are not stored in a succinct vector
+static uint8_t GetKernelWidth(const SegmentRepresentation *representation) {
+	return representation ? representation->GetWidth() : 0;
+}
+
 void ColumnSegment::Skip(ColumnScanState &state) {
-	function->skip(*this, state, state.row_index - state.internal_index);
+	GetScanFunction(state).skip(*this, state, state.row_index - state.internal_index);
 	state.internal_index = state.row_index;
 }
 
-void ColumnSegment::Scan(ColumnScanState &state, idx_t scan_count, Vector &result) {
-	column_segment_catalog->AddReadAccess(this);
+bool ColumnSegment::SelfCompacting() const {
+	return !column_segment_catalog->AdaptiveCompactionEnabled() && type.InternalType() != PhysicalType::VARCHAR;
+}
 
-	if (!compacted && !background_compaction_enabled) {
-		//std::cout << "\n\nCOMPACT IN FULL SCAN??\n\n" << std::endl;
-		Compact();
+bool ColumnSegment::HasOverflowStrings() const {
+	if (type.InternalType() != PhysicalType::VARCHAR || !segment_state) {
+		return false;
 	}
+	return ((UncompressedStringSegmentState &)*segment_state).head != nullptr;
+}
 
-	bit_compression_lock.lock();
-	if (force_reinitializing_scan_state) {
-		InitializeScan(state);
-		force_reinitializing_scan_state = false;
+void ColumnSegment::PrepareScan(ColumnScanState &state) {
+	if (!compacted && SelfCompacting() && succinct_possible) {
+		// scans never wait for an append or another compaction: if one is running the segment is compacted later
+		SegmentTransitionScope transition(this);
+		unique_lock<mutex> guard(bit_compression_lock, std::try_to_lock);
+		if (guard.owns_lock()) {
+			CompactInternal();
+		}
 	}
-	bit_compression_lock.unlock();
+}
 
-	function->scan_vector(*this, state, scan_count, result);
+void ColumnSegment::Scan(ColumnScanState &state, idx_t scan_count, Vector &result) {
+	if (!state.segment_pruned) {
+		column_segment_catalog->AddScanAccess(this);
+	}
+	PrepareScan(state);
+
+	if (MeasureKernels()) {
+		PerfEventMeasurement measurement;
+		GetScanFunction(state).scan_vector(*this, state, scan_count, result);
+		column_segment_catalog->RecordKernel(SegmentKernel::SCAN, GetKernelWidth(state.representation.get()),
+		                                     scan_count, measurement.Finish());
+		return;
+	}
+	GetScanFunction(state).scan_vector(*this, state, scan_count, result);
 }
 
 void ColumnSegment::ScanPartial(ColumnScanState &state, idx_t scan_count, Vector &result, idx_t result_offset) {
-	column_segment_catalog->AddReadAccess(this);
+	// the rows of a segment pruned by its zonemap are only read because they share a vector with the next segment
+	if (!state.segment_pruned) {
+		column_segment_catalog->AddScanAccess(this);
+	}
+	PrepareScan(state);
 
-	if (!compacted && !background_compaction_enabled) {
-		//std::cout << "\n\nCOMPACT IN PARTIAL SCAN? of segment " << this << std::endl;
-		Compact();
+	if (MeasureKernels()) {
+		PerfEventMeasurement measurement;
+		GetScanFunction(state).scan_partial(*this, state, scan_count, result, result_offset);
+		column_segment_catalog->RecordKernel(SegmentKernel::SCAN, GetKernelWidth(state.representation.get()),
+		                                     scan_count, measurement.Finish());
+		return;
 	}
+	GetScanFunction(state).scan_partial(*this, state, scan_count, result, result_offset);
+}
 
-	bit_compression_lock.lock();
-	if (force_reinitializing_scan_state) {
-		InitializeScan(state);
-		force_reinitializing_scan_state = false;
+bool ColumnSegment::ScanShared(ColumnScanState &state, const shared_ptr<const SharedSuccinctFrame> shared_frames[],
+                               idx_t scan_count, Vector &result, idx_t result_offset) {
+	auto representation = state.representation.get();
+	if (!representation || !representation->shared_frame || !representation->compacted ||
+	    representation->encoding != SuccinctEncoding::FRAME_OF_REFERENCE) {
+		return false;
+	}
+	auto shared_frame = shared_frames[representation->padded ? 1 : 0].get();
+	if (!shared_frame || representation->frame_of_reference != shared_frame->frame_of_reference ||
+	    representation->GetWidth() != shared_frame->width) {
+		return false;
+	}
+	auto &frame = *shared_frame;
+	auto start = GetRelativeIndex(state.row_index);
+	if (start + scan_count > representation->packed_count || MeasureKernels()) {
+		// the rows of the delta buffer are not packed, the counters are measured per segment by the regular scan
+		return false;
 	}
-	bit_compression_lock.unlock();
+	if (!state.segment_pruned) {
+		column_segment_catalog->AddScanAccess(this);
+	}
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	frame.unpack(FlatVector::GetData(result) + result_offset * type_size, representation->succinct_vec->data(), start,
+	             scan_count, frame.frame_of_reference);
+	return true;
+}
+
+bool ColumnSegment::FilterCompressed(ColumnScanState &state, idx_t scan_count, Vector &result,
+                                     const TableFilter &filter, SelectionVector &sel, idx_t &approved_tuple_count) {
+	auto &scan_function = GetScanFunction(state);
+	if (!scan_function.filter) {
+		return false;
+	}
+	PrepareScan(state);
+	if (MeasureKernels()) {
+		PerfEventMeasurement measurement;
+		if (!scan_function.filter(*this, state, scan_count, result, filter, sel, approved_tuple_count)) {
+			return false;
+		}
+		column_segment_catalog->RecordKernel(SegmentKernel::FILTER, GetKernelWidth(state.representation.get()),
+		                                     scan_count, measurement.Finish());
+	} else if (!scan_function.filter(*this, state, scan_count, result, filter, sel, approved_tuple_count)) {
+		return false;
+	}
+	// only count the read once the filter was evaluated, the fallback scan counts it otherwise
+	column_segment_catalog->AddScanAccess(this);
+	if (approved_tuple_count > 0) {
+		column_segment_catalog->AddReadAccess(this);
+	}
+	return true;
+}
+
+void ColumnSegment::RecordQualifyingRead() {
+	column_segment_catalog->AddReadAccess(this);
+}
 
-	function->scan_partial(*this, state, scan_count, result, result_offset);
+bool ColumnSegment::AggregateCompressed(ColumnScanState &state, idx_t scan_count, SegmentAggregate &result) {
+	auto &scan_function = GetScanFunction(state);
+	if (!scan_function.aggregate) {
+		return false;
+	}
+	PrepareScan(state);
+	if (MeasureKernels()) {
+		PerfEventMeasurement measurement;
+		if (!scan_function.aggregate(*this, state, scan_count, result)) {
+			return false;
+		}
+		column_segment_catalog->RecordKernel(SegmentKernel::AGGREGATE, GetKernelWidth(state.representation.get()),
+		                                     scan_count, measurement.Finish());
+	} else if (!scan_function.aggregate(*this, state, scan_count, result)) {
+		return false;
+	}
+	// the values are read without being materialized, this still counts as a scan of the segment
+	column_segment_catalog->AddScanAccess(this);
+	return true;
 }
 
 //===--------------------------------------------------------------------===//
 // Fetch
 //===--------------------------------------------------------------------===//
 void ColumnSegment::FetchRow(ColumnFetchState &state, row_t row_id, Vector &result, idx_t result_idx) {
-	function->fetch_row(*this, state, row_id - this->start, result, result_idx);
+	column_segment_catalog->AddReadAccess(this);
+	if (!succinct_possible) {
+		function->fetch_row(*this, state, row_id - this->start, result, result_idx);
+		return;
+	}
+	state.representation = GetRepresentation();
+	if (state.representation->spilled) {
+		state.representation = LoadSpilled();
+	}
+	if (MeasureKernels()) {
+		PerfEventMeasurement measurement;
+		state.representation->function->fetch_row(*this, state, row_id - this->start, result, result_idx);
+		column_segment_catalog->RecordKernel(SegmentKernel::FETCH, GetKernelWidth(state.representation.get()), 1,
+		                                     measurement.Finish());
+	} else {
+		state.representation->function->fetch_row(*this, state, row_id - this->start, result, result_idx);
+	}
+	state.representation.reset();
+}
+
+void ColumnSegment::FetchRows(ColumnFetchState &state, const row_t *row_ids, idx_t count, Vector &result,
+                              idx_t result_offset) {
+	// a batch of point accesses counts as one read, like a scanned vector
+	column_segment_catalog->AddReadAccess(this);
+	// all rows are read from the same representation
+	auto fetch_function = function;
+	if (succinct_possible) {
+		state.representation = GetRepresentation();
+		if (state.representation->spilled) {
+			state.representation = LoadSpilled();
+		}
+		fetch_function = state.representation->function;
+	}
+	unique_ptr<PerfEventMeasurement> measurement;
+	if (MeasureKernels()) {
+		measurement = make_unique<PerfEventMeasurement>();
+	}
+	if (!fetch_function->fetch_rows) {
+		for (idx_t i = 0; i < count; i++) {
+			fetch_function->fetch_row(*this, state, row_ids[i] - this->start, result, result_offset + i);
+		}
+	} else {
+		row_t relative_ids[STANDARD_VECTOR_SIZE];
+		for (idx_t offset = 0; offset < count; offset += STANDARD_VECTOR_SIZE) {
+			idx_t batch_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, count - offset);
+			for (idx_t i = 0; i < batch_count; i++) {
+				relative_ids[i] = row_ids[offset + i] - this->start;
+			}
+			fetch_function->fetch_rows(*this, state, relative_ids, batch_count, result, result_offset + offset);
+		}
+	}
+	if (measurement) {
+		column_segment_catalog->RecordKernel(SegmentKernel::FETCH, GetKernelWidth(state.representation.get()), count,
+		                                     measurement->Finish());
+	}
+	state.representation.reset();
 }
 
 //===--------------------------------------------------------------------===//
@@ -206,24 +425,67 @@ idx_t  ColumnSegment::GetDataSize() const {
 		return 0;
 	}
 
-	if (function->type == CompressionType::COMPRESSION_SUCCINCT) {
-		return sdsl::size_in_bytes(succinct_vec);
+	auto current = GetRepresentation();
+	if (current && (current->succinct_vec || current->spilled)) {
+		return current->SizeInBytes();
 	}
 
 	return segment_size;
 }
 
 idx_t ColumnSegment::SuccinctSize() const {
-	if (function->type == CompressionType::COMPRESSION_SUCCINCT) {
-		return sdsl::size_in_bytes(succinct_vec);
+	auto current = GetRepresentation();
+	if (current && current->succinct_vec) {
+		return current->SizeInBytes();
 	}
 
 	return 0;
 }
 
+uint8_t ColumnSegment::EstimateSuccinctWidth(bool pad_to_byte) {
+	auto current = GetRepresentation();
+	if (current && current->compacted) {
+		return current->GetWidth();
+	}
+	if (type.InternalType() == PhysicalType::VARCHAR) {
+		// the number of distinct strings is only known once they are compacted, at most every row gets its own code
+		pad_to_byte = pad_to_byte || DBConfig::GetConfig(db).succinct_padded_to_next_byte_enabled;
+		return SuccinctPrimitives::MinimumBitWidth(count > 0 ? count - 1 : 0, pad_to_byte);
+	}
+	if (!stats.statistics || count == 0 || !TypeIsIntegral(type.InternalType())) {
+		// the width of FLOAT and DOUBLE values is only known once they are compacted
+		return type_size * 8;
+	}
+	auto &numeric_stats = (NumericStatistics &)*stats.statistics;
+	if (numeric_stats.min.IsNull() || numeric_stats.max.IsNull()) {
+		return type_size * 8;
+	}
+	auto min = numeric_stats.min.GetValue<hugeint_t>();
+	auto max = numeric_stats.max.GetValue<hugeint_t>();
+	if (max < min) {
+		return type_size * 8;
+	}
+	uint64_t range;
+	Hugeint::TryCast<uint64_t>(max - min, range);
+	pad_to_byte = pad_to_byte || DBConfig::GetConfig(db).succinct_padded_to_next_byte_enabled;
+	auto width = SuccinctPrimitives::MinimumBitWidth(range, pad_to_byte);
+	return MinValue<uint8_t>(width, type_size * 8);
+}
+
+bool ColumnSegment::TryEstimateSuccinctSize(bool pad_to_byte, uint8_t &width, idx_t &size) {
+	unique_lock<mutex> guard(bit_compression_lock, std::try_to_lock);
+	if (!guard.owns_lock()) {
+		return false;
+	}
+	width = EstimateSuccinctWidth(pad_to_byte);
+	// for strings this only covers the codes, the size of their dictionary is only known once they are compacted
+	size = compacted ? SuccinctSize() : SuccinctPrimitives::GetRequiredSize(count, width);
+	return true;
+}
+
 void ColumnSegment::Resize(idx_t new_size) {
-	// Succinct is read only
-	D_ASSERT(function->type != CompressionType::COMPRESSION_SUCCINCT);
+	// In-memory succinct vectors are not stored in the block
+	D_ASSERT(!HasSuccinctVector());
 	D_ASSERT(new_size > this->segment_size);
 	D_ASSERT(offset == 0);
 	auto &buffer_manager = BufferManager::GetBufferManager(db);
@@ -250,259 +512,566 @@ idx_t ColumnSegment::Append(ColumnAppendState &state, UnifiedVectorFormat &appen
 		throw InternalException("Attempting to append to a segment without append method");
 	}
 
+	// appends are serialized with the (background) compaction of the segment, scans are not affected
+	SegmentTransitionScope transition(this);
+	lock_guard<mutex> guard(bit_compression_lock);
 	bool uncompacted = false;
 	if (IsBitCompressed()) {
-		//std::cout << "Append but its compacted -> uncompact" << std::endl;
-		Uncompact();
-		InitializeAppend(state);
-		uncompacted = true;
+		// the rows go to the delta buffer of the compacted segment, which keeps its packed rows. String segments have
+		// no delta buffer.
+		if (type.InternalType() != PhysicalType::VARCHAR &&
+		    ReserveDelta(MinValue<idx_t>(count, segment_size / type_size - this->count))) {
+			column_segment_catalog->RecordDeltaAppend();
+		} else {
+			UncompactInternal();
+			InitializeAppend(state);
+			uncompacted = true;
+		}
 	}
 
-	//bit_compression_lock.lock();
 	idx_t copy_count = function->append(*state.append_state, *this, stats, append_data, offset, count);
 	num_elements += count;
-	//bit_compression_lock.unlock();
 
-	if (!compacted && !background_compaction_enabled && (num_elements >= succinct_vec.size() || uncompacted)) {
-		Compact();
+	// a full segment is (re-)compacted including the rows buffered in its delta, otherwise the background compaction
+	// packs them
+	if (SelfCompacting() && (num_elements >= segment_size / type_size || uncompacted)) {
+		CompactInternal();
 	}
 
 	return copy_count;
 }
 
-void ColumnSegment::Compact() {
-	//std::cout << "Before acquiring lock..." << std::endl;
-	//lock_guard<mutex> lock(bit_compression_lock);
-	//std::cout << "Acquired lock!" << std::endl;
-
-	if (compacted || !function || num_elements == 0 || !succinct_possible) {
-		return;
-	}
-	//std::cout << "Start compacting" << std::endl;
-
-	if (function->type == CompressionType::COMPRESSION_SUCCINCT) {
-		size_t size_before_compress = sdsl::size_in_bytes(succinct_vec);
-
-		BitCompressFromSuccinct();
+void ColumnSegment::Compact(SuccinctEncoding max_encoding, bool pad_to_byte) {
+	SegmentTransitionScope transition(this);
+	lock_guard<mutex> guard(bit_compression_lock);
+	CompactInternal(max_encoding, pad_to_byte);
+}
 
-		//std::cout << "Size before compress: " << size_before_compress << ", after: " << sdsl::size_in_bytes(succinct_vec) << std::endl;
-		int64_t diff_size = size_before_compress - sdsl::size_in_bytes(succinct_vec);
-		BufferManager::GetBufferManager(db).AddToDataSize(-diff_size);
+void ColumnSegment::Uncompact() {
+	SegmentTransitionScope transition(this);
+	lock_guard<mutex> guard(bit_compression_lock);
+	UncompactInternal();
+}
 
-		return;
+idx_t ColumnSegment::ReclaimMemory() {
+	SegmentTransitionScope transition(this);
+	unique_lock<mutex> guard(bit_compression_lock, std::try_to_lock);
+	if (!guard.owns_lock() || !succinct_possible || num_elements == 0) {
+		return 0;
+	}
+	int64_t freed_memory = 0;
+	auto current = GetRepresentation();
+	if (!compacted || current->delta_vec) {
+		idx_t size_before_compress = current->SizeInBytes();
+		if (compacted) {
+			// only pack the appended rows, the segment keeps its encoding
+			CompactInternal(current->max_encoding, current->padded);
+		} else {
+			CompactInternal();
+		}
+		freed_memory += int64_t(size_before_compress) - int64_t(GetRepresentation()->SizeInBytes());
 	}
+	// if a scan still reads the uncompressed representation, the block is dropped by a later call
+	freed_memory += ReleaseUncompressedBlock();
+	return freed_memory > 0 ? idx_t(freed_memory) : 0;
+}
 
-	/*
-	std::cout << "Start compacting..." << std::endl;
-	std::cout << "Adress: " << this
-	    	  << ", is compacted: " << compacted
-	      	  << ", size: " << segment_size
-	          << ", type: " << type.ToString()
-			  << std::endl;
-    */
+//! Append a vector of a representation (or its absence) to the bytes written to the spill file
+static void SerializeSpilledVector(vector<data_t> &buffer, const sdsl::int_vector<> *vec) {
+	uint64_t header[2] = {NumericLimits<uint64_t>::Maximum(), 0};
+	idx_t data_size = 0;
+	if (vec) {
+		header[0] = vec->size();
+		header[1] = vec->width();
+		data_size = (vec->bit_size() + 63) / 64 * sizeof(uint64_t);
+	}
+	auto offset = buffer.size();
+	buffer.resize(offset + sizeof(header) + data_size);
+	memcpy(buffer.data() + offset, header, sizeof(header));
+	if (data_size > 0) {
+		memcpy(buffer.data() + offset + sizeof(header), vec->data(), data_size);
+	}
+}
 
-	//! Segment was uncompressed transient and now gets compacted using a succinct representation.
-	succinct_vec.width(type_size * 8);
-	succinct_vec.resize(segment_size / type_size);
+static shared_ptr<sdsl::int_vector<>> DeserializeSpilledVector(data_ptr_t &ptr) {
+	uint64_t header[2];
+	memcpy(header, ptr, sizeof(header));
+	ptr += sizeof(header);
+	if (header[0] == NumericLimits<uint64_t>::Maximum()) {
+		return nullptr;
+	}
+	auto vec = make_shared<sdsl::int_vector<>>(header[0], 0, uint8_t(header[1]));
+	idx_t data_size = (vec->bit_size() + 63) / 64 * sizeof(uint64_t);
+	memcpy(vec->data(), ptr, data_size);
+	ptr += data_size;
+	return vec;
+}
 
-	//size_t size_before_compress = sdsl::size_in_bytes(succinct_vec);
-	//std::cout << "Size before compress: " << size_before_compress << ", segment size: " << segment_size << std::endl;
+idx_t ColumnSegment::Spill() {
+	SegmentTransitionScope transition(this);
+	unique_lock<mutex> guard(bit_compression_lock, std::try_to_lock);
+	if (!guard.owns_lock() || !succinct_possible || !compacted) {
+		return 0;
+	}
+	idx_t freed_memory = ReleaseUncompressedBlock();
+	if (has_uncompressed_block) {
+		// a scan still reads the uncompressed block, the segment is spilled by a later call
+		return freed_memory;
+	}
+	auto current = GetRepresentation();
+	if (current->spilled || !current->succinct_vec || current->delta_vec) {
+		// a segment that is appended to is packed first
+		return freed_memory;
+	}
+	auto spill_region = current->spill_region;
+	if (!spill_region) {
+		auto spill_file = column_segment_catalog->GetSpillFile();
+		if (!spill_file) {
+			return freed_memory;
+		}
+		vector<data_t> buffer;
+		SerializeSpilledVector(buffer, current->succinct_vec.get());
+		SerializeSpilledVector(buffer, current->auxiliary_vec.get());
+		SerializeSpilledVector(buffer, current->exception_vec.get());
+		SerializeSpilledVector(buffer, current->string_vec.get());
+		spill_region = spill_file->Write(buffer.data(), buffer.size());
+	}
 
-	BitCompressFromUncompressed();
+	// scans that took the in-memory representation keep reading it until they finish
+	idx_t vector_memory = current->SizeInBytes();
+	auto spilled_representation = make_shared<SegmentRepresentation>(*current);
+	spilled_representation->spilled = true;
+	spilled_representation->spilled_width = current->GetWidth();
+	spilled_representation->succinct_vec.reset();
+	spilled_representation->auxiliary_vec.reset();
+	spilled_representation->exception_vec.reset();
+	spilled_representation->string_vec.reset();
+	spilled_representation->spill_region = move(spill_region);
+	PublishRepresentation(move(spilled_representation));
+
+	BufferManager::GetBufferManager(db).AddToDataSize(-int64_t(vector_memory));
+	column_segment_catalog->RecordSpill(vector_memory);
+	return freed_memory + vector_memory;
+}
 
-	idx_t size_after_compress = sdsl::size_in_bytes(succinct_vec);
-	int64_t diff_size = segment_size - size_after_compress;
-	// FIX changing also #current_memory in buffer manager
-	BufferManager::GetBufferManager(db).AddToDataSize(-diff_size);
-	// FIXME: Check if we need to update segment_size??
-	//segment_size = size_after_compress;
-	//std::cout << "Finish compacting" << std::endl;
+shared_ptr<SegmentRepresentation> ColumnSegment::LoadSpilled() {
+	SegmentTransitionScope transition(this);
+	lock_guard<mutex> guard(bit_compression_lock);
+	return LoadSpilledInternal();
+}
 
-	//std::cout << "Finished compacting" << std::endl;
+shared_ptr<SegmentRepresentation> ColumnSegment::LoadSpilledInternal() {
+	auto current = GetRepresentation();
+	if (!current || !current->spilled) {
+		// e.g. another scan loaded it while this one waited for the lock
+		return current;
+	}
+	auto &region = *current->spill_region;
+	auto buffer = unique_ptr<data_t[]>(new data_t[region.size]);
+	region.file->Read(region, buffer.get());
+
+	// the loaded representation keeps the region, so the segment can be dropped again without writing it
+	auto loaded_representation = make_shared<SegmentRepresentation>(*current);
+	loaded_representation->spilled = false;
+	loaded_representation->spilled_width = 0;
+	data_ptr_t ptr = buffer.get();
+	loaded_representation->succinct_vec = DeserializeSpilledVector(ptr);
+	loaded_representation->auxiliary_vec = DeserializeSpilledVector(ptr);
+	loaded_representation->exception_vec = DeserializeSpilledVector(ptr);
+	loaded_representation->string_vec = DeserializeSpilledVector(ptr);
+	BufferManager::GetBufferManager(db).AddToDataSize(loaded_representation->SizeInBytes());
+	column_segment_catalog->RecordSpillLoad();
+	PublishRepresentation(loaded_representation);
+	return loaded_representation;
 }
 
-void ColumnSegment::Uncompact() {
-	//lock_guard<mutex> lock(bit_compression_lock);
+idx_t ColumnSegment::ReleaseUncompressedBlock() {
+	if (!compacted || !has_uncompressed_block || !block_representation.expired()) {
+		return 0;
+	}
+	// only the compacted representation is left, which never reads the block
+	idx_t block_memory = block ? block->GetMemoryUsage() : 0;
+	block.reset();
+	block_id = INVALID_BLOCK;
+	has_uncompressed_block = false;
+	UpdateReclaimState();
+	return block_memory;
+}
 
-	if (!compacted || !function || function->type != CompressionType::COMPRESSION_SUCCINCT) {
-		//std::cout << "Uncompact early return??" << std::endl;
+void ColumnSegment::CompactInternal(SuccinctEncoding max_encoding, bool pad_to_byte) {
+	if (num_elements == 0 || !succinct_possible || HasOverflowStrings()) {
 		return;
 	}
 
-	//std::cout << "Start Uncompacting segment" << std::endl;
-
-	size_t compressed_size = sdsl::size_in_bytes(succinct_vec);
-
-	UncompressSuccinct();
-	//compacted = false;
-	//force_reinitializing_scan_state = true;
+	pad_to_byte = pad_to_byte || DBConfig::GetConfig(db).succinct_padded_to_next_byte_enabled;
+	auto current = GetRepresentation();
+	if (current->compacted && current->max_encoding == max_encoding && current->padded == pad_to_byte &&
+	    !current->delta_vec && !SharedFrameChanged(*current)) {
+		return;
+	}
+	// re-encoding reads the values
+	current = LoadSpilledInternal();
+	idx_t size_before_compress = current->SizeInBytes();
 
-	// TODO: Check if that makes sense
-	size_t uncompressed_size = segment_size;
-	int64_t diff_size = uncompressed_size - compressed_size;
-	BufferManager::GetBufferManager(db).AddToDataSize(diff_size);
+	unique_ptr<PerfEventMeasurement> measurement;
+	if (MeasureKernels()) {
+		measurement = make_unique<PerfEventMeasurement>();
+	}
+	Profiler profiler;
+	profiler.Start();
+	// build the compacted representation while scans keep reading the current one
+	auto compacted_representation = BitCompress(*current, max_encoding, pad_to_byte);
+	idx_t size_after_compress = compacted_representation->SizeInBytes();
+	uint8_t compacted_width = GetKernelWidth(compacted_representation.get());
+	PublishRepresentation(move(compacted_representation));
+	profiler.End();
+	if (measurement) {
+		column_segment_catalog->RecordKernel(SegmentKernel::COMPACTION, compacted_width, num_elements,
+		                                     measurement->Finish());
+	}
 
-	//std::cout << "Finished uncompacting" << std::endl;
+	// the uncompressed block stays charged to the buffer manager until it is evicted or released
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	buffer_manager.AddToDataSize(int64_t(size_after_compress) - int64_t(size_before_compress));
+	if (!current->succinct_vec) {
+		buffer_manager.AddOnlyToDataSize(-int64_t(segment_size));
+	}
+	if (current->delta_vec) {
+		column_segment_catalog->RecordDeltaMerge();
+	}
+	column_segment_catalog->RecordCompaction(idx_t(profiler.Elapsed() * 1e9));
 }
 
-void ColumnSegment::BitCompressFromSuccinct() {
-	//std::cout << "Start bit compressing from succinct" << std::endl;
-	//std::cout << "Updated min: " << GetMinFactor() << ", Updated max: " << GetMax() << std::endl;
-	uint64_t min = GetMinFactor();
-	uint64_t max = GetMax() - GetMinFactor();
-	//std::cout << "Min: " << min << ", Max: " << max << std::endl;
-
-    uint8_t min_width = sdsl::bits::hi(max) + 1;
-	if (DBConfig::GetConfig(db).succinct_padded_to_next_byte_enabled) {
-		min_width = ((min_width + 7) & (-8));
-		//std::cout << "Padded min width: " << (unsigned) min_width << std::endl;
+bool ColumnSegment::SharedFrameChanged(const SegmentRepresentation &current) const {
+	if (!current.shared_frame || !column_metadata) {
+		return false;
 	}
+	auto frame = column_metadata->GetFrame(current.padded);
+	return frame && (frame->frame_of_reference != current.frame_of_reference || frame->width != current.GetWidth());
+}
 
-    uint8_t old_width = succinct_vec.width();
-
-    if (old_width > min_width) {
-        const uint64_t* read_data = succinct_vec.data();
-        uint64_t* write_data = succinct_vec.data();
-        uint8_t read_offset = 0;
-        uint8_t write_offset = 0;
+void ColumnSegment::UncompactInternal() {
+	if (!compacted || !succinct_possible) {
+		return;
+	}
 
-        for (size_t i = 0; i < count; ++i) {
-            uint64_t x = sdsl::bits::read_int_and_move(read_data, read_offset, old_width);
-			if (min != UINT64_MAX) {
-				x -= min;
-			}
-            sdsl::bits::write_int_and_move(write_data, x, write_offset, min_width);
-        }
+	auto current = LoadSpilledInternal();
+	idx_t compressed_size = current->SizeInBytes();
+	unique_ptr<PerfEventMeasurement> measurement;
+	if (MeasureKernels()) {
+		measurement = make_unique<PerfEventMeasurement>();
+	}
+	Profiler profiler;
+	profiler.Start();
+	if (!has_uncompressed_block || current->delta_vec) {
+		// the block that was kept since the compaction does not hold the rows appended to the delta buffer
+		UncompressSuccinct(*current);
+	}
 
-        succinct_vec.bit_resize(count * min_width);
-        succinct_vec.width(min_width);
-    }
+	auto uncompacted_representation = make_shared<SegmentRepresentation>();
+	uncompacted_representation->function =
+	    DBConfig::GetConfig(db).GetCompressionFunction(CompressionType::COMPRESSION_UNCOMPRESSED, type.InternalType());
+	block_representation = uncompacted_representation;
+	PublishRepresentation(move(uncompacted_representation));
+	profiler.End();
+	if (measurement) {
+		// attributed to the width that was decoded
+		column_segment_catalog->RecordKernel(SegmentKernel::UNCOMPACTION, GetKernelWidth(current.get()), num_elements,
+		                                     measurement->Finish());
+	}
 
-	SetBitCompressed();
-	//std::cout << "End bit compressing from succinct" << std::endl;
+	// a new uncompressed block is charged to the buffer manager when it is allocated
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	buffer_manager.AddToDataSize(-int64_t(compressed_size));
+	buffer_manager.AddOnlyToDataSize(int64_t(segment_size));
+	column_segment_catalog->RecordUncompaction(idx_t(profiler.Elapsed() * 1e9));
 }
 
-void ColumnSegment::BitCompressFromUncompressed() {
-	auto& buffer_manager = BufferManager::GetBufferManager(db);
-	auto old_handle = buffer_manager.Pin(block);
-	auto uncompressed_ptr = old_handle.Ptr();
-
-	uint64_t min = UINT64_MAX; //GetMinFactor();
-	uint64_t max = 0; //GetMax() - GetMinFactor();
-	for (size_t i = 0; i < count; ++i) {
-		uint64_t curr;
-		memcpy(/* dest= */ &curr,
-		       /* src= */ uncompressed_ptr + i * type_size,
-		       /* n= */ type_size);
+void ColumnSegment::PublishRepresentation(shared_ptr<SegmentRepresentation> new_representation) {
+	new_representation->published_at = Timestamp::GetCurrentTimestamp();
+	function = new_representation->function;
+	compacted = new_representation->compacted;
+	std::atomic_store(&representation, move(new_representation));
+	UpdateReclaimState();
+}
 
-		min = std::min(min, curr);
-		max = std::max(max, curr);
+void ColumnSegment::UpdateReclaimState() {
+	auto current = GetRepresentation();
+	if (!current || !is_data_segment) {
+		return;
 	}
+	// compacting the segment, packing its delta buffer or dropping its uncompressed block frees memory
+	bool reclaimable = !compacted || has_uncompressed_block || current->delta_vec;
+	bool spillable = compacted && !current->spilled && current->succinct_vec && !current->delta_vec;
+	column_segment_catalog->UpdateReclaimableSegments(counted_reclaimable, reclaimable, counted_spillable, spillable);
+	counted_reclaimable = reclaimable;
+	counted_spillable = spillable;
+}
 
-	/*
-	std::cout << "Min: " << min
-	    	  << ", Max: " << max
-	          << std::endl;
-	          */
-
-	if (max != 0 && min != UINT64_MAX && max > min) {
-		// Delta compression.
-		max -= min;
+//! Pack the values of a segment into the smallest of the encodings up to 'max_encoding'. The frame of reference of
+//! FRAME_OF_REFERENCE is the minimum of the segment statistics, which only cover the valid values: NULL rows are packed
+//! as arbitrary values. With 'column_metadata' a FRAME_OF_REFERENCE segment is rebased on the frame shared by the
+//! column if that costs at most MAX_SHARED_WIDTH_OVERHEAD bits per value.
+template <class T>
+static void BitCompressValues(SegmentRepresentation &result, const SegmentRepresentation &current,
+                              const_data_ptr_t uncompressed, idx_t count, BaseStatistics &statistics,
+                              bool pad_to_byte, SuccinctEncoding max_encoding,
+                              ColumnSuccinctMetadata *column_metadata) {
+	unique_ptr<T[]> decoded;
+	auto values = (const T *)uncompressed;
+	if (current.succinct_vec) {
+		// the values are stored in a succinct vector (an uncompacted one or one of another encoding)
+		decoded = unique_ptr<T[]>(new T[count]);
+		SuccinctEncoder::Decode<T>(current, 0, count, decoded.get());
+		values = decoded.get();
 	}
 
-    uint8_t min_width = sdsl::bits::hi(max) + 1;
-	if (DBConfig::GetConfig(db).succinct_padded_to_next_byte_enabled) {
-		min_width = ((min_width + 7) & (-8));
-		//std::cout << "Padded min width: " << (unsigned) min_width << std::endl;
+	auto &numeric_stats = (NumericStatistics &)statistics;
+	T min = T(0);
+	T max = T(0);
+	bool has_values = false;
+	if (!numeric_stats.min.IsNull() && !numeric_stats.max.IsNull() &&
+	    numeric_stats.min.GetValueUnsafe<T>() <= numeric_stats.max.GetValueUnsafe<T>()) {
+		min = numeric_stats.min.GetValueUnsafe<T>();
+		max = numeric_stats.max.GetValueUnsafe<T>();
+		has_values = true;
+	}
+	SuccinctEncoder::Encode<T>(result, values, count, min, max, pad_to_byte, max_encoding);
+	if (!column_metadata || !has_values || result.encoding != SuccinctEncoding::FRAME_OF_REFERENCE) {
+		return;
 	}
 
-    uint8_t old_width = succinct_vec.width();
-	//std::cout << "Compact with min " << min << std::endl;
-    if (old_width > min_width) {
-
-        //const uint64_t* read_data = succinct_vec.data();
-        uint64_t* write_data = succinct_vec.data();
-        //uint8_t read_offset = 0;
-        uint8_t write_offset = 0;
-
-        for (size_t i = 0; i < count; ++i) {
-			int64_t x_flat;
-			memcpy(/* dest= */ &x_flat,
-			       /* src= */ uncompressed_ptr + i * type_size,
-			       /* n= */ type_size);
+	// the shared frame covers the values of the segment, only the width can grow
+	auto frame = column_metadata->TryAddRange<T>(min, max, result.GetWidth(), pad_to_byte);
+	if (!frame) {
+		return;
+	}
+	if (frame->frame_of_reference != result.frame_of_reference || frame->width != result.GetWidth()) {
+		SuccinctEncoder::Encode<T>(result, values, count, T(frame->frame_of_reference), T(frame->maximum),
+		                           pad_to_byte, SuccinctEncoding::FRAME_OF_REFERENCE);
+		result.max_encoding = max_encoding;
+	}
+	result.shared_frame = true;
+}
 
-			//std::cout << "Curr element at " << i << ": " << (int32_t) x_flat << std::endl;
-			//uint64_t x = sdsl::bits::read_int_and_move(read_data, read_offset, old_width);
-			//std::cout << "Compact entry at " << i << " is " << x << std::endl;
+//! Pack FLOAT or DOUBLE values, as decimals if they all convert to them without loss and as bits otherwise
+template <class T>
+static void BitCompressFloatingValues(SegmentRepresentation &result, const SegmentRepresentation &current,
+                                      const_data_ptr_t uncompressed, idx_t count, bool pad_to_byte,
+                                      SuccinctEncoding max_encoding) {
+	unique_ptr<T[]> decoded;
+	auto values = (const T *)uncompressed;
+	if (current.succinct_vec) {
+		decoded = unique_ptr<T[]>(new T[count]);
+		SuccinctEncoder::Decode<T>(current, 0, count, decoded.get());
+		values = decoded.get();
+	}
+	SuccinctEncoder::EncodeFloating<T>(result, values, count, pad_to_byte, max_encoding);
+}
 
-			if (min != UINT64_MAX) {
-				x_flat -= min;
-			}
+//! Build the dictionary of the strings of a segment, read from the uncompressed block or the current dictionary
+static void BitCompressStrings(SegmentRepresentation &result, const SegmentRepresentation &current,
+                               const_data_ptr_t uncompressed, idx_t count, bool pad_to_byte,
+                               SuccinctEncoding max_encoding) {
+	vector<string_t> values(count);
+	if (current.string_vec) {
+		SuccinctEncoder::DecodeStrings(current, 0, count, values.data());
+	} else {
+		// the offsets count the bytes of the strings from the end of the block, segments with overflow strings (with
+		// negative offsets) are not compacted
+		auto dictionary_end = Load<uint32_t>(uncompressed + sizeof(uint32_t));
+		auto offsets = (const int32_t *)(uncompressed + UncompressedStringStorage::DICTIONARY_HEADER_SIZE);
+		int32_t previous_offset = 0;
+		for (idx_t i = 0; i < count; i++) {
+			D_ASSERT(offsets[i] >= previous_offset);
+			auto string_ptr = (const char *)(uncompressed + dictionary_end - offsets[i]);
+			values[i] = string_t(string_ptr, uint32_t(offsets[i] - previous_offset));
+			previous_offset = offsets[i];
+		}
+	}
+	SuccinctEncoder::EncodeStrings(result, values.data(), count, pad_to_byte, max_encoding);
+}
 
-            sdsl::bits::write_int_and_move(write_data, (uint64_t) x_flat, write_offset, min_width);
-        }
+shared_ptr<SegmentRepresentation> ColumnSegment::BitCompress(const SegmentRepresentation &current,
+                                                             SuccinctEncoding max_encoding, bool pad_to_byte) {
+	auto &config = DBConfig::GetConfig(db);
+	auto result = make_shared<SegmentRepresentation>();
+	result->function = config.GetCompressionFunction(CompressionType::COMPRESSION_SUCCINCT, type.InternalType());
+	result->compacted = true;
+	result->packed_count = count;
+
+	BufferHandle handle;
+	const_data_ptr_t uncompressed = nullptr;
+	if (!current.succinct_vec) {
+		handle = BufferManager::GetBufferManager(db).Pin(block);
+		uncompressed = handle.Ptr();
+	}
 
-        succinct_vec.bit_resize(count * min_width);
-        succinct_vec.width(min_width);
+	D_ASSERT(stats.statistics);
+	auto &statistics = *stats.statistics;
+	// segments are only rebased on the frame shared by the column while succinct_shared_frame_enabled is set
+	auto shared_metadata = config.succinct_shared_frame_enabled ? column_metadata.get() : nullptr;
+	switch (type.InternalType()) {
+	case PhysicalType::INT8:
+		BitCompressValues<int8_t>(*result, current, uncompressed, count, statistics, pad_to_byte, max_encoding,
+		                          shared_metadata);
+		break;
+	case PhysicalType::UINT8:
+		BitCompressValues<uint8_t>(*result, current, uncompressed, count, statistics, pad_to_byte, max_encoding,
+		                           shared_metadata);
+		break;
+	case PhysicalType::INT16:
+		BitCompressValues<int16_t>(*result, current, uncompressed, count, statistics, pad_to_byte, max_encoding,
+		                           shared_metadata);
+		break;
+	case PhysicalType::UINT16:
+		BitCompressValues<uint16_t>(*result, current, uncompressed, count, statistics, pad_to_byte, max_encoding,
+		                            shared_metadata);
+		break;
+	case PhysicalType::INT32:
+		BitCompressValues<int32_t>(*result, current, uncompressed, count, statistics, pad_to_byte, max_encoding,
+		                           shared_metadata);
+		break;
+	case PhysicalType::UINT32:
+		BitCompressValues<uint32_t>(*result, current, uncompressed, count, statistics, pad_to_byte, max_encoding,
+		                            shared_metadata);
+		break;
+	case PhysicalType::INT64:
+		BitCompressValues<int64_t>(*result, current, uncompressed, count, statistics, pad_to_byte, max_encoding,
+		                           shared_metadata);
+		break;
+	case PhysicalType::UINT64:
+		BitCompressValues<uint64_t>(*result, current, uncompressed, count, statistics, pad_to_byte, max_encoding,
+		                            shared_metadata);
+		break;
+	case PhysicalType::FLOAT:
+		BitCompressFloatingValues<float>(*result, current, uncompressed, count, pad_to_byte, max_encoding);
+		break;
+	case PhysicalType::DOUBLE:
+		BitCompressFloatingValues<double>(*result, current, uncompressed, count, pad_to_byte, max_encoding);
+		break;
+	case PhysicalType::VARCHAR:
+		BitCompressStrings(*result, current, uncompressed, count, pad_to_byte, max_encoding);
+		break;
+	default:
+		throw InternalException("Unsupported type for succinct compaction");
+	}
+	return result;
+}
 
-		//old_handle.Destroy();
-    }
+bool ColumnSegment::ReserveDelta(idx_t append_count) {
+	auto current = LoadSpilledInternal();
+	if (count < current->packed_count) {
+		// an append that was packed has been reverted, the rows are overwritten in the uncompacted segment
+		return false;
+	}
+	idx_t delta_count = count - current->packed_count;
+	if (delta_count + append_count > MAX_DELTA_COUNT) {
+		if (append_count > MAX_DELTA_COUNT) {
+			return false;
+		}
+		// pack the buffered rows with the options the segment was compacted with
+		CompactInternal(current->max_encoding, current->padded);
+		current = GetRepresentation();
+		delta_count = 0;
+	}
+	idx_t capacity = current->delta_vec ? current->delta_vec->size() : 0;
+	if (delta_count + append_count <= capacity) {
+		return true;
+	}
 
-	lock_guard<mutex> lock(bit_compression_lock);
-	function = DBConfig::GetConfig(db).GetCompressionFunction(CompressionType::COMPRESSION_SUCCINCT, type.InternalType());
-	function->type = CompressionType::COMPRESSION_SUCCINCT;
+	// grow the buffer into a copy, scans keep reading the rows of the one they started on
+	idx_t new_capacity = MaxValue<idx_t>(2 * capacity, STANDARD_VECTOR_SIZE);
+	new_capacity = MinValue<idx_t>(MaxValue<idx_t>(new_capacity, delta_count + append_count), MAX_DELTA_COUNT);
+	auto new_delta = make_shared<sdsl::int_vector<>>(new_capacity, 0, type_size * 8);
+	if (current->delta_vec) {
+		// both buffers store the values with the width of the type
+		memcpy(new_delta->data(), current->delta_vec->data(),
+		       (current->delta_vec->bit_size() + 63) / 64 * sizeof(uint64_t));
+	}
+	idx_t old_size = current->delta_vec ? sdsl::size_in_bytes(*current->delta_vec) : 0;
+	idx_t new_size = sdsl::size_in_bytes(*new_delta);
+	auto new_representation = make_shared<SegmentRepresentation>(*current);
+	new_representation->delta_vec = move(new_delta);
+	PublishRepresentation(move(new_representation));
+	BufferManager::GetBufferManager(db).AddToDataSize(int64_t(new_size) - int64_t(old_size));
+	return true;
+}
 
-	SetBitCompressed();
+//! Write the strings of a compacted segment into a new uncompressed block, in the layout of the uncompressed string
+//! storage. The block held the same strings when the segment was compacted, so they fit.
+static void UncompressStrings(const SegmentRepresentation &current, idx_t count, idx_t segment_size,
+                              data_ptr_t data_ptr) {
+	auto offsets = (int32_t *)(data_ptr + UncompressedStringStorage::DICTIONARY_HEADER_SIZE);
+	uint32_t dictionary_size = 0;
+	string_t values[STANDARD_VECTOR_SIZE];
+	for (idx_t start = 0; start < count; start += STANDARD_VECTOR_SIZE) {
+		idx_t batch_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, count - start);
+		SuccinctEncoder::DecodeStrings(current, start, batch_count, values);
+		for (idx_t i = 0; i < batch_count; i++) {
+			// empty strings (and NULLs) repeat the offset of the row before
+			auto string_length = values[i].GetSize();
+			dictionary_size += string_length;
+			D_ASSERT(UncompressedStringStorage::DICTIONARY_HEADER_SIZE + (start + i + 1) * sizeof(int32_t) +
+			             dictionary_size <=
+			         segment_size);
+			memcpy(data_ptr + segment_size - dictionary_size, values[i].GetDataUnsafe(), string_length);
+			offsets[start + i] = int32_t(dictionary_size);
+		}
+	}
+	Store<uint32_t>(dictionary_size, data_ptr);
+	Store<uint32_t>(uint32_t(segment_size), data_ptr + sizeof(uint32_t));
 }
 
-void ColumnSegment::UncompressSuccinct() {
-	auto& buffer_manager = BufferManager::GetBufferManager(db);
+void ColumnSegment::UncompressSuccinct(const SegmentRepresentation &current) {
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
 
+	// decode into a new block while scans keep reading the succinct vector
 	shared_ptr<BlockHandle> uncompressed_block;
-	//std::cout << "Allocate block of size " << segment_size << std::endl;
+	BufferHandle handle;
 	if (segment_size < Storage::BLOCK_SIZE) {
 		uncompressed_block = buffer_manager.RegisterSmallMemory(segment_size);
+		handle = buffer_manager.Pin(uncompressed_block);
 	} else {
-		buffer_manager.Allocate(segment_size, false, &uncompressed_block);
+		handle = buffer_manager.Allocate(segment_size, false, &uncompressed_block);
 	}
+	data_ptr_t data_ptr = handle.Ptr();
 
-	this->block_id = uncompressed_block->BlockId();
-	this->block = move(uncompressed_block);
-
-	auto handle = buffer_manager.Pin(block);
-	uint8_t* data_ptr = handle.Ptr();
-
-	//std::cout << "Starting uncompressing for loop" << std::endl;
-	//std::cout << "Succinct vec size: " << succinct_vec.size() << std::endl;
-	/*
-	std::cout << "Segment size: " << segment_size
-	          << ", succinct size: " << succinct_vec.size()
-	          << ", succinct width: " << succinct_vec.width()
-	          << ", type size: " << type_size
-	          << std::endl;
-	*/
-
-	for (size_t i = 0; i < succinct_vec.size(); ++i) {
-		//std::cout << "Curr i: " << i << ", size: " << succinct_vec.size() << std::endl;
-		uint64_t curr = uint64_t(succinct_vec[i]) + GetMinFactor();
-		memcpy(/* target= */ data_ptr + i * type_size,
-		       /* source= */ &curr,
-		       /* size= */ type_size);
+	// integers are decoded as unsigned values of the same width, which keeps their bits
+	switch (type.InternalType()) {
+	case PhysicalType::INT8:
+	case PhysicalType::UINT8:
+		SuccinctEncoder::Decode<uint8_t>(current, 0, count, (uint8_t *)data_ptr);
+		break;
+	case PhysicalType::INT16:
+	case PhysicalType::UINT16:
+		SuccinctEncoder::Decode<uint16_t>(current, 0, count, (uint16_t *)data_ptr);
+		break;
+	case PhysicalType::INT32:
+	case PhysicalType::UINT32:
+		SuccinctEncoder::Decode<uint32_t>(current, 0, count, (uint32_t *)data_ptr);
+		break;
+	case PhysicalType::INT64:
+	case PhysicalType::UINT64:
+		SuccinctEncoder::Decode<uint64_t>(current, 0, count, (uint64_t *)data_ptr);
+		break;
+	case PhysicalType::FLOAT:
+		SuccinctEncoder::Decode<float>(current, 0, count, (float *)data_ptr);
+		break;
+	case PhysicalType::DOUBLE:
+		SuccinctEncoder::Decode<double>(current, 0, count, (double *)data_ptr);
+		break;
+	case PhysicalType::VARCHAR:
+		UncompressStrings(current, count, segment_size, data_ptr);
+		break;
+	default:
+		throw InternalException("Unsupported type for succinct uncompaction");
 	}
-	//std::cout << "After uncompresssing for loop" << std::endl;
-
-	lock_guard<mutex> lock(bit_compression_lock);
 
-	function = DBConfig::GetConfig(db).GetCompressionFunction(
-	    CompressionType::COMPRESSION_UNCOMPRESSED, type.InternalType());
-	function->type = CompressionType::COMPRESSION_UNCOMPRESSED;
-	SetBitUncompressed();
-
-	succinct_vec.resize(0);
-
-	force_reinitializing_scan_state = true;
-	//buffer_manager.Unpin(block);
-	//std::cout << "End uncompressing" << std::endl;
+	// only uncompressed representations read the block, and none of them has been published yet
+	this->block_id = uncompressed_block->BlockId();
+	this->block = move(uncompressed_block);
+	has_uncompressed_block = true;
 }
 
 idx_t ColumnSegment::FinalizeAppend(ColumnAppendState &state) {
@@ -528,9 +1097,7 @@ void ColumnSegment::RevertAppend(idx_t start_row) {
 //===--------------------------------------------------------------------===//
 void ColumnSegment::ConvertToPersistent(BlockManager *block_manager, block_id_t block_id_p) {
 	D_ASSERT(segment_type == ColumnSegmentType::TRANSIENT);
-	if (function->type == CompressionType::COMPRESSION_SUCCINCT) {
-		return;
-	}
+	D_ASSERT(!HasSuccinctVector());
 	segment_type = ColumnSegmentType::PERSISTENT;
 
 	block_id = block_id_p;
@@ -316,6 +316,14 @@ void ListColumnData::FetchRow(TransactionData transaction, ColumnFetchState &sta
 	}
 }
 
+void ListColumnData::FetchRows(TransactionData transaction, ColumnFetchState &state, const row_t *row_ids,
+                               idx_t count, Vector &result, idx_t result_offset) {
+	// the child entries of every list are appended to the result in order, so lists are fetched one by one
+	for (idx_t i = 0; i < count; i++) {
+		FetchRow(transaction, state, row_ids[i], result, result_offset + i);
+	}
+}
+
 void ListColumnData::CommitDropColumn() {
 	validity.CommitDropColumn();
 	child_column->CommitDropColumn();
@@ -302,13 +302,15 @@ bool RowGroup::CheckZonemapSegments(RowGroupScanState &state) {
 			D_ASSERT(target_row <= this->start + this->count);
 			idx_t target_vector_index = (target_row - this->start) / STANDARD_VECTOR_SIZE;
 			if (state.vector_index == target_vector_index) {
-				// we can't skip any full vectors because this segment contains less than a full vector
-				// for now we just bail-out
-				// FIXME: we could check if we can ALSO skip the next segments, in which case skipping a full vector
-				// might be possible
-				// we don't care that much though, since a single segment that fits less than a full vector is
-				// exceedingly rare
-				return true;
+				// the rest of this vector lies in the next segments: skip it only if their zonemaps prune it as well
+				idx_t vector_end = MinValue<idx_t>(this->start + (state.vector_index + 1) * STANDARD_VECTOR_SIZE,
+				                                   this->start + this->count);
+				if (columns[base_column_idx]->CheckZonemapRange(state.column_scans[column_idx], vector_end,
+				                                                *entry.second)) {
+					return true;
+				}
+				NextVector(state);
+				return false;
 			}
 			while (state.vector_index < target_vector_index) {
 				NextVector(state);
@@ -327,6 +329,7 @@ void RowGroup::TemplatedScan(TransactionData transaction, RowGroupScanState &sta
 	auto table_filters = state.GetFilters();
 	auto &column_ids = state.GetColumnIds();
 	auto adaptive_filter = state.GetAdaptiveFilter();
+	auto aggregate_pushdown = state.GetAggregatePushdown();
 	while (true) {
 		if (state.vector_index * STANDARD_VECTOR_SIZE >= state.max_row) {
 			// exceeded the amount of rows to scan
@@ -360,6 +363,12 @@ void RowGroup::TemplatedScan(TransactionData transaction, RowGroupScanState &sta
 		} else {
 			count = max_count;
 		}
+		if (TYPE == TableScanType::TABLE_SCAN_REGULAR && aggregate_pushdown && count == max_count &&
+		    !table_filters && AggregateCompressed(state, *aggregate_pushdown, count)) {
+			// the vector was aggregated on the compressed data, it is not emitted
+			NextVector(state);
+			continue;
+		}
 		if (count == max_count && !table_filters) {
 			// scan all vectors completely: full scan without deletions or table filters
 			for (idx_t i = 0; i < column_ids.size(); i++) {
@@ -456,6 +465,32 @@ void RowGroup::TemplatedScan(TransactionData transaction, RowGroupScanState &sta
 	}
 }
 
+bool RowGroup::AggregateCompressed(RowGroupScanState &state, AggregatePushdownState &aggregate_pushdown,
+                                   idx_t count) {
+	auto &column_ids = state.GetColumnIds();
+	auto &aggregated = aggregate_pushdown.pushdown.aggregated;
+	for (idx_t i = 0; i < column_ids.size(); i++) {
+		if (!aggregated[i]) {
+			// the values of the column are not needed
+			continue;
+		}
+		auto column = column_ids[i];
+		D_ASSERT(column != COLUMN_IDENTIFIER_ROW_ID);
+		auto &vector_aggregate = aggregate_pushdown.vector_aggregates[i];
+		vector_aggregate.Reset();
+		if (!columns[column]->AggregateCompressed(state.column_scans[i], count, vector_aggregate)) {
+			return false;
+		}
+	}
+	aggregate_pushdown.row_count += count;
+	for (idx_t i = 0; i < column_ids.size(); i++) {
+		if (aggregated[i]) {
+			aggregate_pushdown.column_aggregates[i].Combine(aggregate_pushdown.vector_aggregates[i]);
+		}
+	}
+	return true;
+}
+
 void RowGroup::Scan(TransactionData transaction, RowGroupScanState &state, DataChunk &result) {
 	TemplatedScan<TableScanType::TABLE_SCAN_REGULAR>(transaction, state, result);
 }
@@ -538,6 +573,23 @@ void RowGroup::FetchRow(TransactionData transaction, ColumnFetchState &state, co
 	}
 }
 
+void RowGroup::FetchRows(TransactionData transaction, ColumnFetchState &state, const vector<column_t> &column_ids,
+                         const row_t *row_ids, idx_t count, DataChunk &result, idx_t result_offset) {
+	for (idx_t col_idx = 0; col_idx < column_ids.size(); col_idx++) {
+		auto column = column_ids[col_idx];
+		if (column == COLUMN_IDENTIFIER_ROW_ID) {
+			// row id column: fill in the row ids
+			D_ASSERT(result.data[col_idx].GetType().InternalType() == PhysicalType::INT64);
+			result.data[col_idx].SetVectorType(VectorType::FLAT_VECTOR);
+			auto data = FlatVector::GetData<row_t>(result.data[col_idx]);
+			memcpy(data + result_offset, row_ids, count * sizeof(row_t));
+		} else {
+			// regular column: fetch data from the base column
+			columns[column]->FetchRows(transaction, state, row_ids, count, result.data[col_idx], result_offset);
+		}
+	}
+}
+
 void RowGroup::AppendVersionInfo(TransactionData transaction, idx_t count) {
 	idx_t row_group_start = this->count.load();
 	idx_t row_group_end = row_group_start + count;
@@ -195,6 +195,10 @@ void RowGroupCollection::Fetch(TransactionData transaction, DataChunk &result, c
 	// figure out which row_group to fetch from
 	auto row_ids = FlatVector::GetData<row_t>(row_identifiers);
 	idx_t count = 0;
+	// consecutive visible rows of the same row_group are fetched as one batch, in the order of the row ids
+	RowGroup *batch_row_group = nullptr;
+	row_t batch_ids[STANDARD_VECTOR_SIZE];
+	idx_t batch_count = 0;
 	for (idx_t i = 0; i < fetch_count; i++) {
 		auto row_id = row_ids[i];
 		RowGroup *row_group;
@@ -210,9 +214,20 @@ void RowGroupCollection::Fetch(TransactionData transaction, DataChunk &result, c
 		if (!row_group->Fetch(transaction, row_id - row_group->start)) {
 			continue;
 		}
-		row_group->FetchRow(transaction, state, column_ids, row_id, result, count);
+		if (row_group != batch_row_group || batch_count == STANDARD_VECTOR_SIZE) {
+			if (batch_count > 0) {
+				batch_row_group->FetchRows(transaction, state, column_ids, batch_ids, batch_count, result,
+				                           count - batch_count);
+			}
+			batch_row_group = row_group;
+			batch_count = 0;
+		}
+		batch_ids[batch_count++] = row_id;
 		count++;
 	}
+	if (batch_count > 0) {
+		batch_row_group->FetchRows(transaction, state, column_ids, batch_ids, batch_count, result, count - batch_count);
+	}
 	result.SetCardinality(count);
 }
 
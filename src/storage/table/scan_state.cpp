@@ -5,13 +5,18 @@
 
 namespace duckdb {
 
-void TableScanState::Initialize(vector<column_t> column_ids, TableFilterSet *table_filters) {
+void TableScanState::Initialize(vector<column_t> column_ids, TableFilterSet *table_filters,
+                                AggregatePushdown *aggregate_pushdown) {
 	this->column_ids = move(column_ids);
 	this->table_filters = table_filters;
 	if (table_filters) {
 		D_ASSERT(table_filters->filters.size() > 0);
 		this->adaptive_filter = make_unique<AdaptiveFilter>(table_filters);
 	}
+	if (aggregate_pushdown) {
+		D_ASSERT(aggregate_pushdown->aggregated.size() == this->column_ids.size());
+		this->aggregate_pushdown = make_unique<AggregatePushdownState>(*aggregate_pushdown);
+	}
 }
 
 const vector<column_t> &TableScanState::GetColumnIds() {
@@ -28,6 +33,10 @@ AdaptiveFilter *TableScanState::GetAdaptiveFilter() {
 	return adaptive_filter.get();
 }
 
+AggregatePushdownState *TableScanState::GetAggregatePushdown() {
+	return aggregate_pushdown.get();
+}
+
 void ColumnScanState::NextInternal(idx_t count) {
 	if (!current) {
 		//! There is no column segment
@@ -38,6 +47,7 @@ void ColumnScanState::NextInternal(idx_t count) {
 		current = (ColumnSegment *)current->Next();
 		initialized = false;
 		segment_checked = false;
+		segment_pruned = false;
 		if (!current) {
 			break;
 		}
@@ -68,6 +78,10 @@ AdaptiveFilter *RowGroupScanState::GetAdaptiveFilter() {
 	return parent.GetAdaptiveFilter();
 }
 
+AggregatePushdownState *RowGroupScanState::GetAggregatePushdown() {
+	return parent.GetAggregatePushdown();
+}
+
 idx_t RowGroupScanState::GetParentMaxRow() {
 	return parent.max_row;
 }
@@ -84,6 +98,10 @@ AdaptiveFilter *CollectionScanState::GetAdaptiveFilter() {
 	return parent.GetAdaptiveFilter();
 }
 
+AggregatePushdownState *CollectionScanState::GetAggregatePushdown() {
+	return parent.GetAggregatePushdown();
+}
+
 bool CollectionScanState::Scan(Transaction &transaction, DataChunk &result) {
 	auto current_row_group = row_group_state.row_group;
 	while (current_row_group) {
@@ -0,0 +1,97 @@
+#include "duckdb/storage/table/segment_spill_file.hpp"
+
+#include "duckdb/main/database.hpp"
+
+namespace duckdb {
+
+SegmentSpillRegion::~SegmentSpillRegion() {
+	file->Free(offset, allocation_size);
+}
+
+SegmentSpillFile::SegmentSpillFile(DatabaseInstance &db, string path_p)
+    : db(db), path(move(path_p)), file_size(0), used_size(0) {
+	auto &fs = FileSystem::GetFileSystem(db);
+	handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_WRITE |
+	                               FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+}
+
+SegmentSpillFile::~SegmentSpillFile() {
+	handle.reset();
+	// the temporary directory may already be gone together with the temporary files of the buffer manager
+	try {
+		auto &fs = FileSystem::GetFileSystem(db);
+		if (fs.FileExists(path)) {
+			fs.RemoveFile(path);
+		}
+	} catch (...) { // NOLINT
+	}
+}
+
+shared_ptr<SegmentSpillRegion> SegmentSpillFile::Write(const_data_ptr_t data, idx_t size) {
+	idx_t allocation_size = AlignValue<idx_t, SPILL_ALIGNMENT>(MaxValue<idx_t>(size, 1));
+	idx_t offset;
+	{
+		lock_guard<mutex> guard(lock);
+		// first fit: the regions of a segment are written and freed as a whole, so the gaps stay reusable
+		auto entry = free_regions.begin();
+		while (entry != free_regions.end() && entry->second < allocation_size) {
+			entry++;
+		}
+		if (entry != free_regions.end()) {
+			offset = entry->first;
+			idx_t remaining = entry->second - allocation_size;
+			free_regions.erase(entry);
+			if (remaining > 0) {
+				free_regions[offset + allocation_size] = remaining;
+			}
+		} else {
+			offset = file_size;
+			file_size += allocation_size;
+		}
+		used_size += allocation_size;
+	}
+	// the region belongs to this thread now, writes to other regions do not need the lock
+	try {
+		handle->Write((void *)data, size, offset);
+	} catch (...) {
+		// e.g. the disk is full
+		Free(offset, allocation_size);
+		throw;
+	}
+	return make_shared<SegmentSpillRegion>(shared_from_this(), offset, size, allocation_size);
+}
+
+void SegmentSpillFile::Read(const SegmentSpillRegion &region, data_ptr_t target) {
+	handle->Read(target, region.size, region.offset);
+}
+
+void SegmentSpillFile::Free(idx_t offset, idx_t size) {
+	lock_guard<mutex> guard(lock);
+	used_size -= size;
+	// merge with the free neighbours
+	auto next = free_regions.lower_bound(offset);
+	if (next != free_regions.end() && offset + size == next->first) {
+		size += next->second;
+		next = free_regions.erase(next);
+	}
+	if (next != free_regions.begin()) {
+		auto previous = std::prev(next);
+		if (previous->first + previous->second == offset) {
+			previous->second += size;
+			return;
+		}
+	}
+	free_regions[offset] = size;
+}
+
+idx_t SegmentSpillFile::GetFileSize() {
+	lock_guard<mutex> guard(lock);
+	return file_size;
+}
+
+idx_t SegmentSpillFile::GetUsedSize() {
+	lock_guard<mutex> guard(lock);
+	return used_size;
+}
+
+} // namespace duckdb
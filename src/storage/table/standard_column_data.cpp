@@ -18,28 +18,51 @@ StandardColumnData::StandardColumnData(ColumnData &original, idx_t start_row, Co
     : ColumnData(original, start_row, parent), validity(((StandardColumnData &)original).validity, start_row, this) {
 }
 
+bool StandardColumnData::CheckSegmentZonemap(ColumnSegment &segment, TableFilter &filter) {
+	// the statistics of transient segments are maintained on every append, so they are as exact as persistent ones
+	auto prune_result = filter.CheckStatistics(*segment.stats.statistics);
+	if (prune_result != FilterPropagateResult::FILTER_ALWAYS_FALSE) {
+		return true;
+	}
+	if (updates) {
+		auto update_stats = updates->GetStatistics();
+		prune_result = filter.CheckStatistics(*update_stats);
+		return prune_result != FilterPropagateResult::FILTER_ALWAYS_FALSE;
+	} else {
+		return false;
+	}
+}
+
 bool StandardColumnData::CheckZonemap(ColumnScanState &state, TableFilter &filter) {
 	if (!state.segment_checked) {
 		if (!state.current) {
 			return true;
 		}
 		state.segment_checked = true;
-		auto prune_result = filter.CheckStatistics(*state.current->stats.statistics);
-		if (prune_result != FilterPropagateResult::FILTER_ALWAYS_FALSE) {
+		if (CheckSegmentZonemap(*state.current, filter)) {
 			return true;
 		}
-		if (updates) {
-			auto update_stats = updates->GetStatistics();
-			prune_result = filter.CheckStatistics(*update_stats);
-			return prune_result != FilterPropagateResult::FILTER_ALWAYS_FALSE;
-		} else {
-			return false;
-		}
+		// the rows of this segment that share a vector with the next segment might still be scanned
+		state.segment_pruned = true;
+		return false;
 	} else {
 		return true;
 	}
 }
 
+bool StandardColumnData::CheckZonemapRange(ColumnScanState &state, idx_t end_row, TableFilter &filter) {
+	if (!state.current) {
+		return true;
+	}
+	auto segment = (ColumnSegment *)state.current->Next();
+	for (; segment && segment->start < end_row; segment = (ColumnSegment *)segment->Next()) {
+		if (CheckSegmentZonemap(*segment, filter)) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void StandardColumnData::InitializeScan(ColumnScanState &state) {
 	ColumnData::InitializeScan(state);
 
@@ -66,6 +89,59 @@ idx_t StandardColumnData::Scan(TransactionData transaction, idx_t vector_index,
 	return scan_count;
 }
 
+void StandardColumnData::Select(TransactionData transaction, idx_t vector_index, ColumnScanState &state,
+                                Vector &result, SelectionVector &sel, idx_t &count, const TableFilter &filter) {
+	D_ASSERT(state.row_index == state.child_states[0].row_index);
+	if (!SelectCompressed(transaction, vector_index, state, result, sel, count, filter)) {
+		ColumnData::Select(transaction, vector_index, state, result, sel, count, filter);
+		return;
+	}
+	// the filter was evaluated on the compressed values: remove the NULLs from the selection
+	validity.Scan(transaction, vector_index, state.child_states[0], result);
+	auto &mask = FlatVector::Validity(result);
+	if (mask.AllValid()) {
+		return;
+	}
+	SelectionVector valid_sel(count);
+	idx_t valid_count = 0;
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = sel.get_index(i);
+		if (mask.RowIsValid(idx)) {
+			valid_sel.set_index(valid_count++, idx);
+		}
+	}
+	sel.Initialize(valid_sel);
+	count = valid_count;
+}
+
+bool StandardColumnData::AggregateCompressed(ColumnScanState &state, idx_t count, SegmentAggregate &result) {
+	D_ASSERT(state.row_index == state.child_states[0].row_index);
+	if (validity.CanHaveNull(state.child_states[0], count)) {
+		// the compressed values do not tell which rows are NULL
+		return false;
+	}
+	if (!result.needs_sum && !result.needs_min_max) {
+		// the rows are only counted
+		result.count += count;
+		return true;
+	}
+	{
+		lock_guard<mutex> update_guard(update_lock);
+		if (updates) {
+			// the compressed data does not contain the updates
+			return false;
+		}
+	}
+	BeginScanVectorInternal(state);
+	auto segment = state.current;
+	D_ASSERT(state.row_index >= segment->start && state.row_index <= segment->start + segment->count);
+	if (state.row_index + count > segment->start + segment->count) {
+		// the rows span multiple segments
+		return false;
+	}
+	return segment->AggregateCompressed(state, count, result);
+}
+
 idx_t StandardColumnData::ScanCommitted(idx_t vector_index, ColumnScanState &state, Vector &result,
                                         bool allow_updates) {
 	D_ASSERT(state.row_index == state.child_states[0].row_index);
@@ -153,6 +229,16 @@ void StandardColumnData::FetchRow(TransactionData transaction, ColumnFetchState
 	ColumnData::FetchRow(transaction, state, row_id, result, result_idx);
 }
 
+void StandardColumnData::FetchRows(TransactionData transaction, ColumnFetchState &state, const row_t *row_ids,
+                                   idx_t count, Vector &result, idx_t result_offset) {
+	if (state.child_states.empty()) {
+		auto child_state = make_unique<ColumnFetchState>();
+		state.child_states.push_back(move(child_state));
+	}
+	validity.FetchRows(transaction, *state.child_states[0], row_ids, count, result, result_offset);
+	ColumnData::FetchRows(transaction, state, row_ids, count, result, result_offset);
+}
+
 void StandardColumnData::CommitDropColumn() {
 	ColumnData::CommitDropColumn();
 	validity.CommitDropColumn();
@@ -229,6 +229,20 @@ void StructColumnData::FetchRow(TransactionData transaction, ColumnFetchState &s
 	}
 }
 
+void StructColumnData::FetchRows(TransactionData transaction, ColumnFetchState &state, const row_t *row_ids,
+                                 idx_t count, Vector &result, idx_t result_offset) {
+	auto &child_entries = StructVector::GetEntries(result);
+	for (idx_t i = state.child_states.size(); i < child_entries.size() + 1; i++) {
+		auto child_state = make_unique<ColumnFetchState>();
+		state.child_states.push_back(move(child_state));
+	}
+	validity.FetchRows(transaction, *state.child_states[0], row_ids, count, result, result_offset);
+	for (idx_t i = 0; i < child_entries.size(); i++) {
+		sub_columns[i]->FetchRows(transaction, *state.child_states[i + 1], row_ids, count, *child_entries[i],
+		                          result_offset);
+	}
+}
+
 void StructColumnData::CommitDropColumn() {
 	validity.CommitDropColumn();
 	for (auto &sub_column : sub_columns) {
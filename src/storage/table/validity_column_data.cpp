@@ -1,6 +1,8 @@
 #include "duckdb/storage/table/validity_column_data.hpp"
 #include "duckdb/storage/table/scan_state.hpp"
 #include "duckdb/storage/table/update_segment.hpp"
+#include "duckdb/storage/table/column_segment.hpp"
+#include "duckdb/storage/statistics/validity_statistics.hpp"
 
 namespace duckdb {
 
@@ -17,4 +19,21 @@ bool ValidityColumnData::CheckZonemap(ColumnScanState &state, TableFilter &filte
 	return true;
 }
 
+bool ValidityColumnData::CanHaveNull(ColumnScanState &state, idx_t count) {
+	{
+		lock_guard<mutex> update_guard(update_lock);
+		if (updates) {
+			return true;
+		}
+	}
+	BeginScanVectorInternal(state);
+	auto segment = state.current;
+	if (state.row_index + count > segment->start + segment->count) {
+		// the rows span multiple segments
+		return true;
+	}
+	auto &validity_stats = (ValidityStatistics &)*segment->stats.statistics;
+	return validity_stats.has_null;
+}
+
 } // namespace duckdb